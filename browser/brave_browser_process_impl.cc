@@ -14,6 +14,7 @@
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service.h"
 #include "brave/components/brave_shields/browser/https_everywhere_service.h"
+#include "brave/components/brave_shields/browser/site_hacks_service.h"
 #include "brave/components/brave_shields/browser/tracking_protection_service.h"
 #include "chrome/browser/io_thread.h"
 #include "components/component_updater/component_updater_service.h"
@@ -123,6 +124,15 @@ BraveBrowserProcessImpl::https_everywhere_service() {
   return https_everywhere_service_.get();
 }
 
+brave_shields::SiteHacksService*
+BraveBrowserProcessImpl::site_hacks_service() {
+  if (site_hacks_service_)
+    return site_hacks_service_.get();
+
+  site_hacks_service_ = brave_shields::SiteHacksServiceFactory();
+  return site_hacks_service_.get();
+}
+
 extensions::BraveTorClientUpdater*
 BraveBrowserProcessImpl::tor_client_updater() {
   if (tor_client_updater_)
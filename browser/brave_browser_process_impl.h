@@ -17,6 +17,7 @@ namespace brave_shields {
 class AdBlockService;
 class AdBlockRegionalService;
 class HTTPSEverywhereService;
+class SiteHacksService;
 class TrackingProtectionService;
 }
 
@@ -37,6 +38,7 @@ class BraveBrowserProcessImpl : public BrowserProcessImpl {
   brave_shields::AdBlockRegionalService* ad_block_regional_service();
   brave_shields::TrackingProtectionService* tracking_protection_service();
   brave_shields::HTTPSEverywhereService* https_everywhere_service();
+  brave_shields::SiteHacksService* site_hacks_service();
   extensions::BraveTorClientUpdater* tor_client_updater();
 
  private:
@@ -47,6 +49,7 @@ class BraveBrowserProcessImpl : public BrowserProcessImpl {
       tracking_protection_service_;
   std::unique_ptr<brave_shields::HTTPSEverywhereService>
       https_everywhere_service_;
+  std::unique_ptr<brave_shields::SiteHacksService> site_hacks_service_;
   std::unique_ptr<brave::BraveStatsUpdater> brave_stats_updater_;
   std::unique_ptr<extensions::BraveTorClientUpdater> tor_client_updater_;
 
@@ -5,11 +5,13 @@
 #include "brave/browser/browser_context_keyed_service_factories.h"
 
 #include "brave/browser/payments/payments_service_factory.h"
+#include "brave/components/brave_shields/browser/brave_shields_stats_service_factory.h"
 
 namespace brave {
 
 void EnsureBrowserContextKeyedServiceFactoriesBuilt() {
   PaymentsServiceFactory::GetInstance();
+  brave_shields::BraveShieldsStatsServiceFactory::GetInstance();
 }
 
 }  // namespace brave
@@ -4,15 +4,17 @@
 
 #include "brave/browser/importer/brave_profile_writer.h"
 #include "brave/common/importer/brave_stats.h"
-#include "brave/common/pref_names.h"
+#include "brave/components/brave_shields/browser/brave_shields_stats_service.h"
+#include "brave/components/brave_shields/browser/brave_shields_stats_service_factory.h"
 #include "brave/utility/importer/brave_importer.h"
 
+#include <utility>
+
 #include "base/time/time.h"
 #include "chrome/browser/profiles/profile.h"
 #include "content/public/browser/browser_context.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/storage_partition.h"
-#include "components/prefs/pref_service.h"
 #include "net/cookies/canonical_cookie.h"
 #include "net/cookies/cookie_constants.h"
 #include "net/url_request/url_request_context.h"
@@ -42,24 +44,29 @@ void BraveProfileWriter::AddCookies(
 }
 
 void BraveProfileWriter::UpdateStats(const BraveStats& stats) {
-  PrefService* prefs = profile_->GetOriginalProfile()->GetPrefs();
-
-  const uint64_t ads_blocked = prefs->GetUint64(kAdsBlocked);
-  const uint64_t trackers_blocked = prefs->GetUint64(kTrackersBlocked);
-  const uint64_t https_upgrades = prefs->GetUint64(kHttpsUpgrades);
+  // The stats service owns the counters while the profile is open and would
+  // overwrite prefs written directly.
+  brave_shields::BraveShieldsStatsService* stats_service =
+      brave_shields::BraveShieldsStatsServiceFactory::GetForProfile(profile_);
+  if (!stats_service) {
+    return;
+  }
 
   // Only update the current stats if they are less than the imported
   // stats; intended to prevent incorrectly updating the stats multiple
   // times from multiple imports.
-  if (ads_blocked < uint64_t{stats.adblock_count}) {
-      prefs->SetUint64(kAdsBlocked, ads_blocked + stats.adblock_count);
-  }
-  if (trackers_blocked < uint64_t{stats.trackingProtection_count}) {
-    prefs->SetUint64(kTrackersBlocked,
-                     trackers_blocked + stats.trackingProtection_count);
-  }
-  if (https_upgrades < uint64_t{stats.httpsEverywhere_count}) {
-    prefs->SetUint64(kHttpsUpgrades,
-                     https_upgrades + stats.httpsEverywhere_count);
+  const std::pair<brave_shields::BlockedStat, uint64_t> imported_stats[] = {
+    { brave_shields::BlockedStat::kAds,
+      static_cast<uint64_t>(stats.adblock_count) },
+    { brave_shields::BlockedStat::kTrackers,
+      static_cast<uint64_t>(stats.trackingProtection_count) },
+    { brave_shields::BlockedStat::kHttpsUpgrades,
+      static_cast<uint64_t>(stats.httpsEverywhere_count) },
+  };
+  for (const auto& imported_stat : imported_stats) {
+    if (stats_service->GetTotal(imported_stat.first) < imported_stat.second) {
+      stats_service->Record(imported_stat.first, -1, std::string(),
+                            imported_stat.second);
+    }
   }
 }
@@ -4,17 +4,83 @@
 
 #include "brave/browser/net/brave_httpse_network_delegate_helper.h"
 
+#include "base/memory/ptr_util.h"
+#include "base/supports_user_data.h"
 #include "base/task_scheduler/post_task.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/browser/net/url_context.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "brave/components/brave_shields/browser/https_everywhere_service.h"
+#include "brave/components/brave_shields/browser/shields_latency_tracker.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "content/public/browser/browser_thread.h"
 #include "net/url_request/url_request.h"
 
+#define HTTPSE_URL_MAX_REDIRECTS_COUNT 5
+
+using brave_shields::ScopedShieldsLatencyTimer;
+using brave_shields::ShieldsLatencyStage;
+using brave_shields::ShieldsLatencyTracker;
 using content::BrowserThread;
 
+namespace {
+
+const char kHTTPSERedirectsCountKey[] = "brave_httpse_redirects_count";
+
+// Number of times HTTPS Everywhere rewrote a request. It lives on the request
+// itself, so it survives the redirects it is counting and goes away with the
+// request.
+class HTTPSERedirectsCount : public base::SupportsUserData::Data {
+ public:
+  HTTPSERedirectsCount() : count_(0) {}
+  ~HTTPSERedirectsCount() override {}
+
+  static unsigned int Get(const net::URLRequest* request) {
+    const HTTPSERedirectsCount* data = static_cast<HTTPSERedirectsCount*>(
+        request->GetUserData(kHTTPSERedirectsCountKey));
+    return data ? data->count_ : 0;
+  }
+
+  static void Increment(net::URLRequest* request) {
+    HTTPSERedirectsCount* data = static_cast<HTTPSERedirectsCount*>(
+        request->GetUserData(kHTTPSERedirectsCountKey));
+    if (!data) {
+      data = new HTTPSERedirectsCount();
+      request->SetUserData(kHTTPSERedirectsCountKey, base::WrapUnique(data));
+    }
+    data->count_++;
+  }
+
+ private:
+  unsigned int count_;
+
+  DISALLOW_COPY_AND_ASSIGN(HTTPSERedirectsCount);
+};
+
+// Rules rewriting back to http, or redirects from the site itself, could
+// otherwise bounce a request between the two schemes forever.
+bool ShouldHTTPSERedirect(const net::URLRequest* request) {
+  return HTTPSERedirectsCount::Get(request) <
+      HTTPSE_URL_MAX_REDIRECTS_COUNT - 1;
+}
+
+// Redirects are reported as kHTTPUpgradableResources whether or not the
+// lookup had to leave the IO thread, which is the block type the shields
+// panel and the stats service count HTTPS upgrades under.
+void ApplyHTTPSERedirect(net::URLRequest* request,
+                         GURL* new_url,
+                         const std::string& new_url_spec) {
+  if (new_url_spec.empty() || new_url_spec == request->url().spec()) {
+    return;
+  }
+  *new_url = GURL(new_url_spec);
+  HTTPSERedirectsCount::Increment(request);
+  brave_shields::DispatchBlockedEventFromIO(request,
+      brave_shields::kHTTPUpgradableResources);
+}
+
+}  // namespace
+
 namespace brave {
 
 void OnBeforeURLRequest_HttpseFileWork(
@@ -22,27 +88,28 @@ void OnBeforeURLRequest_HttpseFileWork(
     GURL* new_url,
     std::shared_ptr<BraveRequestInfo> ctx) {
   base::AssertBlockingAllowed();
-  DCHECK(ctx->request_identifier != 0);
+  TRACE_EVENT0(BRAVE_SHIELDS_TRACE_CATEGORY,
+               "OnBeforeURLRequest_HttpseFileWork");
   g_brave_browser_process->https_everywhere_service()->
-    GetHTTPSURL(&ctx->request_url, ctx->request_identifier, ctx->new_url_spec);
+    GetHTTPSURL(&ctx->request_url, ctx->new_url_spec);
 }
 
 void OnBeforeURLRequest_HttpsePostFileWork(
     net::URLRequest* request,
     GURL* new_url,
     const ResponseCallback& next_callback,
-    std::shared_ptr<BraveRequestInfo> ctx) {
+    std::shared_ptr<BraveRequestInfo> ctx,
+    base::TimeTicks post_time) {
 
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  ShieldsLatencyTracker::GetInstance()->Record(
+      ShieldsLatencyStage::kHTTPSEBlockingPoolHop,
+      base::TimeTicks::Now() - post_time, ctx->request_url,
+      ctx->is_off_the_record);
 
-  if (!ctx->new_url_spec.empty() &&
-    ctx->new_url_spec != request->url().spec()) {
-    *new_url = GURL(ctx->new_url_spec);
-    brave_shields::DispatchBlockedEventFromIO(request,
-        brave_shields::kHTTPUpgradableResources);
-  }
+  ApplyHTTPSERedirect(request, new_url, ctx->new_url_spec);
 
-  next_callback.Run();
+  next_callback.Run(ctx);
 }
 
 int OnBeforeURLRequest_HttpsePreFileWork(
@@ -53,14 +120,12 @@ int OnBeforeURLRequest_HttpsePreFileWork(
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
 
   GURL tab_origin = request->site_for_cookies().GetOrigin();
-  bool allow_brave_shields = brave_shields::IsAllowContentSettingFromIO(
-      request, tab_origin, tab_origin, CONTENT_SETTINGS_TYPE_PLUGINS,
-      brave_shields::kBraveShields);
-  bool allow_http_upgradable_resource = brave_shields::IsAllowContentSettingFromIO(
-      request, tab_origin, tab_origin, CONTENT_SETTINGS_TYPE_PLUGINS,
-      brave_shields::kHTTPUpgradableResources);
-  if (tab_origin.is_empty() || allow_http_upgradable_resource ||
-      !allow_brave_shields) {
+  if (tab_origin.is_empty()) {
+    return net::OK;
+  }
+  brave_shields::ShieldsPolicy policy =
+      brave_shields::GetShieldsPolicyFromIO(request, tab_origin);
+  if (policy.allow_http_upgradable_resources || !policy.allow_brave_shields) {
     return net::OK;
   }
 
@@ -76,10 +141,20 @@ int OnBeforeURLRequest_HttpsePreFileWork(
     }
   }
 
-  if (is_valid_url) {
-    if (!g_brave_browser_process->https_everywhere_service()->
-        GetHTTPSURLFromCacheOnly(&request->url(), request->identifier(),
-          ctx->new_url_spec)) {
+  if (is_valid_url && ShouldHTTPSERedirect(request)) {
+    brave_shields::HTTPSEverywhereService* https_everywhere_service =
+        g_brave_browser_process->https_everywhere_service();
+    bool answered;
+    {
+      ScopedShieldsLatencyTimer timer(ShieldsLatencyStage::kHTTPSELookup,
+                                      request->url(),
+                                      ctx->is_off_the_record);
+      answered = https_everywhere_service->GetHTTPSURLFromMemory(
+          &request->url(), ctx->new_url_spec);
+    }
+    ShieldsLatencyTracker::GetInstance()->RecordCacheLookup(
+        ShieldsLatencyStage::kHTTPSELookup, answered);
+    if (!answered) {
       ctx->request_url = request->url();
 
       scoped_refptr<base::SequencedTaskRunner> task_runner =
@@ -91,14 +166,11 @@ int OnBeforeURLRequest_HttpsePreFileWork(
         base::Bind(base::IgnoreResult(
             &OnBeforeURLRequest_HttpsePostFileWork),
             base::Unretained(request),
-            new_url, next_callback, ctx)
+            new_url, next_callback, ctx, base::TimeTicks::Now())
           );
       return net::ERR_IO_PENDING;
     } else {
-      if (!ctx->new_url_spec.empty()) {
-        *new_url = GURL(ctx->new_url_spec);
-        brave_shields::DispatchBlockedEventFromIO(request, "httpsEverywhere");
-      }
+      ApplyHTTPSERedirect(request, new_url, ctx->new_url_spec);
     }
   }
 
@@ -5,17 +5,39 @@
 #include "brave/browser/net/brave_network_delegate_base.h"
 
 #include <algorithm>
+#include <utility>
 
+#include "base/stl_util.h"
 #include "brave/browser/net/url_context.h"
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "brave/components/brave_shields/browser/shields_latency_tracker.h"
 #include "content/public/browser/browser_thread.h"
 #include "net/url_request/url_request.h"
 
 
+using brave_shields::ShieldsLatencyStage;
+using brave_shields::ShieldsLatencyTracker;
 using content::BrowserThread;
 
+namespace {
+
+void RecordChainLatency(const net::URLRequest* request,
+                        const brave::BraveRequestInfo& ctx) {
+  ShieldsLatencyTracker::GetInstance()->Record(
+      ctx.event_type == brave::kOnBeforeRequest ?
+          ShieldsLatencyStage::kOnBeforeURLRequest :
+          ShieldsLatencyStage::kOnBeforeStartTransaction,
+      base::TimeTicks::Now() - ctx.start_time, request->url(),
+      ctx.is_off_the_record);
+}
+
+}  // namespace
+
 BraveNetworkDelegateBase::BraveNetworkDelegateBase(
     extensions::EventRouterForwarder* event_router) :
     ChromeNetworkDelegate(event_router) {
+  next_callback_ = base::Bind(&BraveNetworkDelegateBase::RunNextCallback,
+                              base::Unretained(this));
 }
 
 BraveNetworkDelegateBase::~BraveNetworkDelegateBase() {
@@ -27,13 +49,23 @@ int BraveNetworkDelegateBase::OnBeforeURLRequest(net::URLRequest* request,
   if (before_url_request_callbacks_.empty() || !request) {
     return ChromeNetworkDelegate::OnBeforeURLRequest(request, std::move(callback), new_url);
   }
-  std::shared_ptr<brave::BraveRequestInfo> ctx(
-      new brave::BraveRequestInfo());
-  callbacks_[request->identifier()] = std::move(callback);
+  std::shared_ptr<brave::BraveRequestInfo> ctx = AcquireContext();
+  ctx->request = request;
+  ctx->new_url = new_url;
   ctx->request_identifier = request->identifier();
   ctx->event_type = brave::kOnBeforeRequest;
-  RunNextCallback(request, new_url, ctx);
-  return net::ERR_IO_PENDING;
+  ctx->start_time = base::TimeTicks::Now();
+  ctx->is_off_the_record = brave_shields::IsOffTheRecordFromIO(request);
+  int rv = RunHandlers(ctx);
+  if (rv == net::ERR_IO_PENDING) {
+    pending_callbacks_[ctx->request_identifier] = std::move(callback);
+    return rv;
+  }
+  RecordChainLatency(request, *ctx);
+  if (rv == net::ERR_ABORTED) {
+    return rv;
+  }
+  return RunChromeNetworkDelegate(ctx.get(), std::move(callback));
 }
 
 int BraveNetworkDelegateBase::OnBeforeStartTransaction(net::URLRequest* request,
@@ -43,84 +75,112 @@ int BraveNetworkDelegateBase::OnBeforeStartTransaction(net::URLRequest* request,
     return ChromeNetworkDelegate::OnBeforeStartTransaction(request, std::move(callback),
                                                            headers);
   }
-  std::shared_ptr<brave::BraveRequestInfo> ctx(
-      new brave::BraveRequestInfo());
-  callbacks_[request->identifier()] = std::move(callback);
+  std::shared_ptr<brave::BraveRequestInfo> ctx = AcquireContext();
+  ctx->request = request;
   ctx->headers = headers;
   ctx->request_identifier = request->identifier();
   ctx->event_type = brave::kOnBeforeStartTransaction;
-  RunNextCallback(request, nullptr, ctx);
-  return net::ERR_IO_PENDING;
+  ctx->start_time = base::TimeTicks::Now();
+  ctx->is_off_the_record = brave_shields::IsOffTheRecordFromIO(request);
+  int rv = RunHandlers(ctx);
+  if (rv == net::ERR_IO_PENDING) {
+    pending_callbacks_[ctx->request_identifier] = std::move(callback);
+    return rv;
+  }
+  RecordChainLatency(request, *ctx);
+  if (rv == net::ERR_ABORTED) {
+    return rv;
+  }
+  return RunChromeNetworkDelegate(ctx.get(), std::move(callback));
 }
 
 void BraveNetworkDelegateBase::RunCallbackForRequestIdentifier(uint64_t request_identifier, int rv) {
-  std::map<uint64_t, net::CompletionOnceCallback>::iterator it =
-      callbacks_.find(request_identifier);
-  std::move(it->second).Run(rv);
+  auto it = pending_callbacks_.find(request_identifier);
+  if (it == pending_callbacks_.end()) {
+    return;
+  }
+  net::CompletionOnceCallback callback = std::move(it->second);
+  pending_callbacks_.erase(it);
+  std::move(callback).Run(rv);
 }
 
-void BraveNetworkDelegateBase::RunNextCallback(
-    net::URLRequest* request,
-    GURL* new_url,
-    std::shared_ptr<brave::BraveRequestInfo> ctx) {
-  DCHECK_CURRENTLY_ON(BrowserThread::IO);
-
-  if (!ContainsKey(callbacks_, ctx->request_identifier)) {
-    return;
+std::shared_ptr<brave::BraveRequestInfo>
+BraveNetworkDelegateBase::AcquireContext() {
+  // Handlers that go asynchronous keep a reference to the context, in which
+  // case the next request gets a new one.
+  if (spare_ctx_ && spare_ctx_.use_count() == 1) {
+    spare_ctx_->Reset();
+  } else {
+    spare_ctx_ = std::make_shared<brave::BraveRequestInfo>();
   }
+  return spare_ctx_;
+}
 
-  // Continue processing callbacks until we hit one that returns PENDING
-  int rv = net::OK;
+int BraveNetworkDelegateBase::RunHandlers(
+    const std::shared_ptr<brave::BraveRequestInfo>& ctx) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  TRACE_EVENT0(BRAVE_SHIELDS_TRACE_CATEGORY,
+               "BraveNetworkDelegateBase::RunHandlers");
 
+  // Continue processing handlers until we hit one that returns PENDING
   if (ctx->event_type == brave::kOnBeforeRequest) {
-    while(before_url_request_callbacks_.size() != ctx->next_url_request_index) {
-      brave::OnBeforeURLRequestCallback callback =
+    while (ctx->next_url_request_index < before_url_request_callbacks_.size()) {
+      brave::OnBeforeURLRequestCallback handler =
           before_url_request_callbacks_[ctx->next_url_request_index++];
-      brave::ResponseCallback next_callback =
-          base::Bind(&BraveNetworkDelegateBase::RunNextCallback,
-              base::Unretained(this), request, new_url, ctx);
-      rv = callback.Run(request, new_url, next_callback, ctx);
-      if (rv == net::ERR_IO_PENDING) {
-        return;
-      }
-      if (rv == net::ERR_ABORTED) {
-        break;
+      int rv = handler(ctx->request, ctx->new_url, next_callback_, ctx);
+      if (rv == net::ERR_IO_PENDING || rv == net::ERR_ABORTED) {
+        return rv;
       }
     }
   } else if (ctx->event_type == brave::kOnBeforeStartTransaction) {
-    while(before_start_transaction_callbacks_.size() != ctx->next_url_request_index) {
-      brave::OnBeforeStartTransactionCallback callback =
+    while (ctx->next_url_request_index <
+           before_start_transaction_callbacks_.size()) {
+      brave::OnBeforeStartTransactionCallback handler =
           before_start_transaction_callbacks_[ctx->next_url_request_index++];
-      brave::ResponseCallback next_callback =
-          base::Bind(&BraveNetworkDelegateBase::RunNextCallback,
-              base::Unretained(this), request, new_url, ctx);
-      rv = callback.Run(request, ctx->headers, next_callback, ctx);
-      if (rv == net::ERR_IO_PENDING) {
-        return;
-      }
-      if (rv == net::ERR_ABORTED) {
-        break;
+      int rv = handler(ctx->request, ctx->headers, next_callback_, ctx);
+      if (rv == net::ERR_IO_PENDING || rv == net::ERR_ABORTED) {
+        return rv;
       }
     }
   }
+  return net::OK;
+}
+
+int BraveNetworkDelegateBase::RunChromeNetworkDelegate(
+    brave::BraveRequestInfo* ctx,
+    net::CompletionOnceCallback callback) {
+  if (ctx->event_type == brave::kOnBeforeRequest) {
+    return ChromeNetworkDelegate::OnBeforeURLRequest(ctx->request,
+        std::move(callback), ctx->new_url);
+  }
+  return ChromeNetworkDelegate::OnBeforeStartTransaction(ctx->request,
+      std::move(callback), ctx->headers);
+}
+
+void BraveNetworkDelegateBase::RunNextCallback(
+    std::shared_ptr<brave::BraveRequestInfo> ctx) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+
+  // The request was destroyed while a handler was pending.
+  if (!ContainsKey(pending_callbacks_, ctx->request_identifier)) {
+    return;
+  }
+
+  int rv = RunHandlers(ctx);
+  if (rv == net::ERR_IO_PENDING) {
+    return;
+  }
+
+  RecordChainLatency(ctx->request, *ctx);
 
-  std::map<uint64_t, net::CompletionOnceCallback>::iterator it =
-      callbacks_.find(ctx->request_identifier);
   if (rv == net::ERR_ABORTED) {
-    std::move(it->second).Run(rv);
+    RunCallbackForRequestIdentifier(ctx->request_identifier, rv);
     return;
   }
 
   net::CompletionOnceCallback wrapped_callback = base::BindOnce(
       &BraveNetworkDelegateBase::RunCallbackForRequestIdentifier, base::Unretained(this), ctx->request_identifier);
-
-  if (ctx->event_type == brave::kOnBeforeRequest) {
-    rv = ChromeNetworkDelegate::OnBeforeURLRequest(request,
-        std::move(wrapped_callback), new_url);
-  } else if (ctx->event_type == brave::kOnBeforeStartTransaction) {
-    rv = ChromeNetworkDelegate::OnBeforeStartTransaction(request,
-        std::move(wrapped_callback), ctx->headers);
-  }
+  rv = RunChromeNetworkDelegate(ctx.get(), std::move(wrapped_callback));
 
   // ChromeNetworkDelegate returns net::ERR_IO_PENDING if an extension is
   // intercepting the request and OK if the request should proceed normally.
@@ -130,8 +190,6 @@ void BraveNetworkDelegateBase::RunNextCallback(
 }
 
 void BraveNetworkDelegateBase::OnURLRequestDestroyed(net::URLRequest* request) {
-  if (ContainsKey(callbacks_, request->identifier())) {
-    callbacks_.erase(request->identifier());
-  }
+  pending_callbacks_.erase(request->identifier());
   ChromeNetworkDelegate::OnURLRequestDestroyed(request);
 }
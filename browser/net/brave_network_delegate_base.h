@@ -5,6 +5,10 @@
 #ifndef BRAVE_BROWSER_NET_BRAVE_NETWORK_DELEGATE_BASE_H_
 #define BRAVE_BROWSER_NET_BRAVE_NETWORK_DELEGATE_BASE_H_
 
+#include <memory>
+
+#include "base/containers/flat_map.h"
+#include "base/containers/span.h"
 #include "brave/browser/net/url_context.h"
 #include "chrome/browser/net/chrome_network_delegate.h"
 #include "net/base/completion_callback.h"
@@ -40,17 +44,35 @@ class BraveNetworkDelegateBase : public ChromeNetworkDelegate {
   void RunCallbackForRequestIdentifier(uint64_t request_identifier, int rv);
 
  protected:
-  void RunNextCallback(
-    net::URLRequest* request,
-    GURL *new_url,
-    std::shared_ptr<brave::BraveRequestInfo> ctx);
-  std::vector<brave::OnBeforeURLRequestCallback>
+  // Resumes the chain of |ctx| once the handler that returned
+  // net::ERR_IO_PENDING is done.
+  void RunNextCallback(std::shared_ptr<brave::BraveRequestInfo> ctx);
+
+  // Set by subclasses, in their constructor, to static arrays of handlers
+  // which run in order.
+  base::span<const brave::OnBeforeURLRequestCallback>
       before_url_request_callbacks_;
-  std::vector<brave::OnBeforeStartTransactionCallback>
+  base::span<const brave::OnBeforeStartTransactionCallback>
       before_start_transaction_callbacks_;
 
  private:
-  std::map<uint64_t, net::CompletionOnceCallback> callbacks_;
+  // Returns a cleared context, reusing the previous one unless a pending
+  // handler still holds it.
+  std::shared_ptr<brave::BraveRequestInfo> AcquireContext();
+  // Runs the handlers left for |ctx| and returns net::OK once all of them
+  // have, net::ERR_ABORTED if one cancelled the request, or
+  // net::ERR_IO_PENDING if one is waiting to call |next_callback_|.
+  int RunHandlers(const std::shared_ptr<brave::BraveRequestInfo>& ctx);
+  // Hands the request over to ChromeNetworkDelegate.
+  int RunChromeNetworkDelegate(brave::BraveRequestInfo* ctx,
+                               net::CompletionOnceCallback callback);
+
+  // Only requests waiting on an asynchronous handler are in here, the others
+  // complete within the NetworkDelegate call.
+  base::flat_map<uint64_t, net::CompletionOnceCallback> pending_callbacks_;
+  // Bound once and shared by every request.
+  brave::ResponseCallback next_callback_;
+  std::shared_ptr<brave::BraveRequestInfo> spare_ctx_;
 
   DISALLOW_COPY_AND_ASSIGN(BraveNetworkDelegateBase);
 };
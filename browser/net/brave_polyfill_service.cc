@@ -0,0 +1,53 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/brave_polyfill_service.h"
+
+#include "base/base64url.h"
+#include "base/lazy_instance.h"
+#include "base/logging.h"
+#include "base/strings/string_piece.h"
+#include "brave/common/network_constants.h"
+#include "brave/grit/brave_generated_resources.h"
+#include "ui/base/resource/resource_bundle.h"
+
+namespace {
+
+base::LazyInstance<brave::PolyfillService>::Leaky g_polyfill_service =
+    LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
+namespace brave {
+
+PolyfillService::PolyfillService() {
+  AddPolyfill("google-tag-manager", IDR_BRAVE_TAG_MANAGER_POLYFILL);
+  AddPolyfill("google-tag-services", IDR_BRAVE_TAG_SERVICES_POLYFILL);
+}
+
+PolyfillService::~PolyfillService() {
+}
+
+// static
+PolyfillService* PolyfillService::GetInstance() {
+  return g_polyfill_service.Pointer();
+}
+
+void PolyfillService::AddPolyfill(const std::string& name, int resource_id) {
+  base::StringPiece script =
+      ui::ResourceBundle::GetSharedInstance().GetRawDataResource(resource_id);
+  std::string encoded;
+  Base64UrlEncode(script, base::Base64UrlEncodePolicy::OMIT_PADDING,
+                  &encoded);
+  GURL url(kJSDataURLPrefix + encoded);
+  DCHECK(url.is_valid()) << name;
+  polyfill_urls_[name] = url;
+}
+
+const GURL* PolyfillService::GetPolyfillURL(const std::string& name) const {
+  auto it = polyfill_urls_.find(name);
+  return it == polyfill_urls_.end() ? nullptr : &it->second;
+}
+
+}  // namespace brave
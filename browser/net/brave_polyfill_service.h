@@ -0,0 +1,41 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_BROWSER_NET_BRAVE_POLYFILL_SERVICE_H_
+#define BRAVE_BROWSER_NET_BRAVE_POLYFILL_SERVICE_H_
+
+#include <map>
+#include <string>
+
+#include "base/macros.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+// Holds the data: URLs that replace the scripts named by polyfill site hacks.
+// They are encoded and parsed once, so substituting a script on the IO
+// thread is a map lookup and a copy. May be used from any thread.
+class PolyfillService {
+ public:
+  PolyfillService();
+  ~PolyfillService();
+
+  static PolyfillService* GetInstance();
+
+  // Returns the replacement for the polyfill |name|, or nullptr if there is
+  // no such polyfill.
+  const GURL* GetPolyfillURL(const std::string& name) const;
+
+ private:
+  void AddPolyfill(const std::string& name, int resource_id);
+
+  // Never modified after construction.
+  std::map<std::string, GURL> polyfill_urls_;
+
+  DISALLOW_COPY_AND_ASSIGN(PolyfillService);
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_BROWSER_NET_BRAVE_POLYFILL_SERVICE_H_
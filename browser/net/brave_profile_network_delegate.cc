@@ -5,26 +5,30 @@
 #include "brave/browser/net/brave_profile_network_delegate.h"
 
 #include "brave/browser/net/brave_httpse_network_delegate_helper.h"
+#include "brave/browser/net/brave_polyfill_service.h"
 #include "brave/browser/net/brave_site_hacks_network_delegate_helper.h"
 
-BraveProfileNetworkDelegate::BraveProfileNetworkDelegate(
-    extensions::EventRouterForwarder* event_router) :
-    BraveNetworkDelegateBase(event_router) {
-  brave::OnBeforeURLRequestCallback callback =
-      base::Bind(
-          brave::OnBeforeURLRequest_SiteHacksWork);
-  before_url_request_callbacks_.push_back(callback);
+namespace {
+
+const brave::OnBeforeURLRequestCallback kBeforeURLRequestCallbacks[] = {
+  brave::OnBeforeURLRequest_SiteHacksWork,
+  brave::OnBeforeURLRequest_HttpsePreFileWork,
+};
 
-  callback =
-      base::Bind(
-          brave::OnBeforeURLRequest_HttpsePreFileWork);
-  before_url_request_callbacks_.push_back(callback);
+const brave::OnBeforeStartTransactionCallback
+    kBeforeStartTransactionCallbacks[] = {
+  brave::OnBeforeStartTransaction_SiteHacksWork,
+};
 
-  brave::OnBeforeStartTransactionCallback start_transactions_callback =
-      base::Bind(
-          brave::OnBeforeStartTransaction_SiteHacksWork);
-  before_start_transaction_callbacks_.push_back(start_transactions_callback);
+}  // namespace
 
+BraveProfileNetworkDelegate::BraveProfileNetworkDelegate(
+    extensions::EventRouterForwarder* event_router) :
+    BraveNetworkDelegateBase(event_router) {
+  before_url_request_callbacks_ = kBeforeURLRequestCallbacks;
+  before_start_transaction_callbacks_ = kBeforeStartTransactionCallbacks;
+  // Encodes the polyfills now rather than on the first request using one.
+  brave::PolyfillService::GetInstance();
 }
 
 BraveProfileNetworkDelegate::~BraveProfileNetworkDelegate() {
@@ -5,69 +5,43 @@
 #include "brave/browser/net/brave_site_hacks_network_delegate_helper.h"
 
 #include <string>
+#include <vector>
 
-#include "base/base64url.h"
 #include "base/sequenced_task_runner.h"
 #include "base/strings/string_util.h"
 #include "base/task_scheduler/post_task.h"
 #include "base/task_scheduler/task_scheduler.h"
+#include "brave/browser/net/brave_polyfill_service.h"
 #include "brave/common/network_constants.h"
-#include "brave/common/shield_exceptions.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
+#include "brave/components/brave_shields/browser/site_hacks_rule_table.h"
+#include "brave/components/brave_shields/browser/site_hacks_service.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
-#include "brave/grit/brave_generated_resources.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/resource_request_info.h"
 #include "content/public/common/referrer.h"
-#include "extensions/common/url_pattern.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
 #include "net/url_request/url_request.h"
-#include "ui/base/resource/resource_bundle.h"
 
+using brave_shields::SiteHackAction;
+using brave_shields::SiteHackRule;
+using brave_shields::SiteHacksRuleTable;
+using brave_shields::SiteHacksService;
 using content::BrowserThread;
 using content::Referrer;
 using namespace net::registry_controlled_domains;
 
 namespace brave {
 
-std::string GetGoogleTagManagerPolyfillJS() {
-  static std::string base64_output;
-  if (base64_output.length() != 0)  {
-    return base64_output;
+bool GetPolyfill(const std::string& name, GURL* new_url) {
+  const GURL* polyfill_url =
+      PolyfillService::GetInstance()->GetPolyfillURL(name);
+  if (!polyfill_url) {
+    return false;
   }
-  std::string str = ui::ResourceBundle::GetSharedInstance().GetRawDataResource(
-    IDR_BRAVE_TAG_MANAGER_POLYFILL).as_string();
-  base64_output.reserve(180);
-  Base64UrlEncode(str, base::Base64UrlEncodePolicy::OMIT_PADDING, &base64_output);
-  base64_output = std::string(kJSDataURLPrefix) + base64_output;
-  return base64_output;
-}
-
-std::string GetGoogleTagServicesPolyfillJS() {
-  static std::string base64_output;
-  if (base64_output.length() != 0)  {
-    return base64_output;
-  }
-  std::string str = ui::ResourceBundle::GetSharedInstance().GetRawDataResource(
-    IDR_BRAVE_TAG_SERVICES_POLYFILL).as_string();
-  base64_output.reserve(4668);
-  Base64UrlEncode(str, base::Base64UrlEncodePolicy::OMIT_PADDING, &base64_output);
-  base64_output = std::string(kJSDataURLPrefix) + base64_output;
-  return base64_output;
-}
-
-bool GetPolyfill(const GURL& gurl, GURL *new_url) {
-  static URLPattern tag_manager(URLPattern::SCHEME_ALL, kGoogleTagManagerPattern);
-  static URLPattern tag_services(URLPattern::SCHEME_ALL, kGoogleTagServicesPattern);
-  if (tag_manager.MatchesURL(gurl)) {
-    std::string&& data_url = GetGoogleTagManagerPolyfillJS();
-    *new_url = GURL(data_url);
-  } else if (tag_services.MatchesURL(gurl)) {
-    std::string&& data_url = GetGoogleTagServicesPolyfillJS();
-    *new_url = GURL(data_url);
-  }
-  return net::OK;
+  *new_url = *polyfill_url;
+  return true;
 }
 
 int OnBeforeURLRequest_SiteHacksWork(
@@ -75,49 +49,47 @@ int OnBeforeURLRequest_SiteHacksWork(
     GURL* new_url,
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx) {
-  const GURL& url = request->url();
-
-  if (IsEmptyDataURLRedirect(url)) {
-    *new_url = GURL(kEmptyDataURI);
-    return net::OK;
-  }
-
-  if (IsBlockedResource(url)) {
-    request->Cancel();
-    return net::ERR_ABORTED;
-  }
-
-  if (GetPolyfill(url, new_url)) {
-    return net::OK;
+  // Keeps |rules| valid if the component swaps in new ones meanwhile.
+  scoped_refptr<const SiteHacksRuleTable> site_hacks =
+      SiteHacksService::GetRules();
+  std::vector<const SiteHackRule*> rules;
+  site_hacks->FindRules(request->url(), &rules);
+  for (const SiteHackRule* rule : rules) {
+    switch (rule->action) {
+      case SiteHackAction::kEmptyDataRedirect:
+        *new_url = GURL(kEmptyDataURI);
+        return net::OK;
+      case SiteHackAction::kBlock:
+        request->Cancel();
+        return net::ERR_ABORTED;
+      case SiteHackAction::kPolyfill:
+        if (GetPolyfill(rule->value, new_url)) {
+          return net::OK;
+        }
+        break;
+      default:
+        break;
+    }
   }
 
   return net::OK;
 }
 
-void CheckForCookieOverride(const GURL& url, const URLPattern& pattern,
-    net::HttpRequestHeaders* headers, const std::string& extra_cookies) {
-  if (pattern.MatchesURL(url)) {
-    std::string cookies;
-    if (headers->GetHeader(kCookieHeader, &cookies)) {
-      cookies = "; ";
-    }
-    cookies += extra_cookies;
-    headers->SetHeader(kCookieHeader, cookies);
+void ApplyCookieOverride(net::HttpRequestHeaders* headers,
+    const std::string& extra_cookies) {
+  std::string cookies;
+  if (headers->GetHeader(kCookieHeader, &cookies)) {
+    cookies = "; ";
   }
+  cookies += extra_cookies;
+  headers->SetHeader(kCookieHeader, cookies);
 }
 
-bool IsBlockTwitterSiteHack(net::URLRequest* request,
+bool IsBlockedFromReferrer(const SiteHackRule& rule,
     net::HttpRequestHeaders* headers) {
-  URLPattern redirectURLPattern(URLPattern::SCHEME_ALL, kTwitterRedirectURL);
-  URLPattern referrerPattern(URLPattern::SCHEME_ALL, kTwitterReferrer);
-  if (redirectURLPattern.MatchesURL(request->url())) {
-    std::string referrer;
-    if (headers->GetHeader(kRefererHeader, &referrer) &&
-        referrerPattern.MatchesURL(GURL(referrer))) {
-      return true;
-    }
-  }
-  return false;
+  std::string referrer;
+  return headers->GetHeader(kRefererHeader, &referrer) &&
+      rule.referrer_pattern.MatchesURL(GURL(referrer));
 }
 
 int ApplyPotentialReferrerBlock(net::URLRequest* request,
@@ -126,16 +98,13 @@ int ApplyPotentialReferrerBlock(net::URLRequest* request,
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
   GURL target_origin = GURL(request->url()).GetOrigin();
   GURL tab_origin = request->site_for_cookies().GetOrigin();
-  bool allow_referrers = brave_shields::IsAllowContentSettingFromIO(
-      request, tab_origin, tab_origin, CONTENT_SETTINGS_TYPE_PLUGINS,
-      brave_shields::kReferrers);
-  bool shields_up = brave_shields::IsAllowContentSettingFromIO(
-      request, tab_origin, GURL(), CONTENT_SETTINGS_TYPE_PLUGINS,
-      brave_shields::kBraveShields);
+  brave_shields::ShieldsPolicy policy =
+      brave_shields::GetShieldsPolicyFromIO(request, tab_origin);
   std::string original_referrer;
   headers->GetHeader(kRefererHeader, &original_referrer);
   Referrer new_referrer;
-  if (brave_shields::ShouldSetReferrer(allow_referrers, shields_up,
+  if (brave_shields::ShouldSetReferrer(policy.allow_referrers,
+          policy.allow_brave_shields,
           GURL(original_referrer), tab_origin, request->url(), target_origin,
           Referrer::NetReferrerPolicyToBlinkReferrerPolicy(
               request->referrer_policy()), &new_referrer)) {
@@ -148,14 +117,31 @@ int OnBeforeStartTransaction_SiteHacksWork(net::URLRequest* request,
         net::HttpRequestHeaders* headers,
         const ResponseCallback& next_callback,
         std::shared_ptr<BraveRequestInfo> ctx) {
-  CheckForCookieOverride(request->url(),
-      URLPattern(URLPattern::SCHEME_ALL, kForbesPattern), headers,
-      kForbesExtraCookies);
-  if (IsBlockTwitterSiteHack(request, headers)) {
-    request->Cancel();
-    return net::ERR_ABORTED;
+  // Keeps |rules| valid if the component swaps in new ones meanwhile.
+  scoped_refptr<const SiteHacksRuleTable> site_hacks =
+      SiteHacksService::GetRules();
+  std::vector<const SiteHackRule*> rules;
+  site_hacks->FindRules(request->url(), &rules);
+  bool user_agent_whitelisted = false;
+  for (const SiteHackRule* rule : rules) {
+    switch (rule->action) {
+      case SiteHackAction::kCookieOverride:
+        ApplyCookieOverride(headers, rule->value);
+        break;
+      case SiteHackAction::kBlockFromReferrer:
+        if (IsBlockedFromReferrer(*rule, headers)) {
+          request->Cancel();
+          return net::ERR_ABORTED;
+        }
+        break;
+      case SiteHackAction::kUserAgentWhitelist:
+        user_agent_whitelisted = true;
+        break;
+      default:
+        break;
+    }
   }
-  if (IsUAWhitelisted(request->url())) {
+  if (user_agent_whitelisted) {
     std::string user_agent;
     if (headers->GetHeader(kUserAgentHeader, &user_agent)) {
       base::ReplaceFirstSubstringAfterOffset(&user_agent, 0, "Chrome", "Brave Chrome");
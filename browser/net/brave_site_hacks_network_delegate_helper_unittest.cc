@@ -4,14 +4,29 @@
 
 #include "brave/browser/net/brave_site_hacks_network_delegate_helper.h"
 
+#include "brave/browser/net/brave_polyfill_service.h"
 #include "brave/browser/net/url_context.h"
 #include "brave/common/network_constants.h"
+#include "brave/components/brave_shields/browser/site_hacks_rule_table.h"
+#include "brave/components/brave_shields/browser/site_hacks_service.h"
 #include "chrome/test/base/chrome_render_view_host_test_harness.h"
 #include "net/traffic_annotation/network_traffic_annotation_test_helper.h"
 #include "net/url_request/url_request_test_util.h"
 
+using brave_shields::SiteHackAction;
+using brave_shields::SiteHackRule;
+using brave_shields::SiteHacksService;
+
 namespace {
 
+// Returns the value of the loaded rule for |action| that matches |url|.
+std::string GetRuleValue(const GURL& url, SiteHackAction action) {
+  const SiteHackRule* rule =
+      SiteHacksService::GetRules()->FindRule(url, action);
+  EXPECT_TRUE(rule) << url;
+  return rule ? rule->value : std::string();
+}
+
 class BraveSiteHacksNetworkDelegateHelperTest: public testing::Test {
  public:
   BraveSiteHacksNetworkDelegateHelperTest()
@@ -72,8 +87,8 @@ TEST_F(BraveSiteHacksNetworkDelegateHelperTest, RedirectsToEmptyDataURLs) {
 
 TEST_F(BraveSiteHacksNetworkDelegateHelperTest, RedirectsToStubs) {
   std::vector<GURL> urls({
-    GURL(kGoogleTagManagerPattern),
-    GURL(kGoogleTagServicesPattern)
+    GURL("https://www.googletagmanager.com/gtm.js"),
+    GURL("https://www.googletagservices.com/tag/js/gpt.js")
   });
   std::for_each(urls.begin(), urls.end(),
       [this](GURL url){
@@ -89,6 +104,11 @@ TEST_F(BraveSiteHacksNetworkDelegateHelperTest, RedirectsToStubs) {
       OnBeforeURLRequest_SiteHacksWork(request.get(), &new_url, callback,
           brave_request_info);
     EXPECT_EQ(ret, net::OK);
+    const GURL* polyfill_url =
+        brave::PolyfillService::GetInstance()->GetPolyfillURL(
+            GetRuleValue(url, SiteHackAction::kPolyfill));
+    ASSERT_TRUE(polyfill_url);
+    EXPECT_EQ(*polyfill_url, new_url);
     EXPECT_TRUE(new_url.SchemeIs("data"));
   });
 }
@@ -130,7 +150,10 @@ TEST_F(BraveSiteHacksNetworkDelegateHelperTest, ForbesWithCookieHeader) {
       callback, brave_request_info);
   std::string cookies;
   headers.GetHeader(kCookieHeader, &cookies);
-  EXPECT_TRUE(cookies.find(std::string("; ") + kForbesExtraCookies) != std::string::npos);
+  std::string extra_cookies =
+      GetRuleValue(url, SiteHackAction::kCookieOverride);
+  EXPECT_FALSE(extra_cookies.empty());
+  EXPECT_TRUE(cookies.find(std::string("; ") + extra_cookies) != std::string::npos);
   EXPECT_EQ(ret, net::OK);
 }
 
@@ -148,7 +171,10 @@ TEST_F(BraveSiteHacksNetworkDelegateHelperTest, ForbesWithoutCookieHeader) {
       callback, brave_request_info);
   std::string cookies;
   headers.GetHeader(kCookieHeader, &cookies);
-  EXPECT_TRUE(cookies.find(kForbesExtraCookies) != std::string::npos);
+  std::string extra_cookies =
+      GetRuleValue(url, SiteHackAction::kCookieOverride);
+  EXPECT_FALSE(extra_cookies.empty());
+  EXPECT_EQ(extra_cookies, cookies);
   EXPECT_EQ(ret, net::OK);
 }
 
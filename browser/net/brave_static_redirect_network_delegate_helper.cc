@@ -4,11 +4,17 @@
 
 #include "brave/browser/net/brave_static_redirect_network_delegate_helper.h"
 
-#include "brave/common/network_constants.h"
+#include <vector>
+
+#include "brave/components/brave_shields/browser/site_hacks_rule_table.h"
+#include "brave/components/brave_shields/browser/site_hacks_service.h"
 #include "components/component_updater/component_updater_url_constants.h"
-#include "extensions/common/url_pattern.h"
 #include "net/url_request/url_request.h"
 
+using brave_shields::SiteHackAction;
+using brave_shields::SiteHackRule;
+using brave_shields::SiteHacksRuleTable;
+using brave_shields::SiteHacksService;
 
 namespace brave {
 
@@ -17,19 +23,23 @@ int OnBeforeURLRequest_StaticRedirectWork(
     GURL* new_url,
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx) {
-  GURL::Replacements replacements;
-  static URLPattern geo_pattern(URLPattern::SCHEME_HTTPS, kGeoLocationsPattern);
-  static URLPattern safeBrowsing_pattern(URLPattern::SCHEME_HTTPS, kSafeBrowsingPrefix);
-
-  if (geo_pattern.MatchesURL(request->url())) {
-    *new_url = GURL(GOOGLEAPIS_ENDPOINT GOOGLEAPIS_API_KEY);
-    return net::OK;
-  }
-
-  if (safeBrowsing_pattern.MatchesHost(request->url())) {
-    replacements.SetHostStr(SAFEBROWSING_ENDPOINT);
-    *new_url = request->url().ReplaceComponents(replacements);
-    return net::OK;
+  // Keeps |rules| valid if the component swaps in new ones meanwhile.
+  scoped_refptr<const SiteHacksRuleTable> site_hacks =
+      SiteHacksService::GetRules();
+  std::vector<const SiteHackRule*> rules;
+  site_hacks->FindRules(request->url(), &rules);
+  for (const SiteHackRule* rule : rules) {
+    if (rule->action == SiteHackAction::kGeolocationRedirect) {
+      *new_url = GURL(GOOGLEAPIS_ENDPOINT GOOGLEAPIS_API_KEY);
+      return net::OK;
+    }
+
+    if (rule->action == SiteHackAction::kSafeBrowsingRedirect) {
+      GURL::Replacements replacements;
+      replacements.SetHostStr(SAFEBROWSING_ENDPOINT);
+      *new_url = request->url().ReplaceComponents(replacements);
+      return net::OK;
+    }
   }
 
   return net::OK;
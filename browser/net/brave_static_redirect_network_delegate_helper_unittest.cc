@@ -110,4 +110,26 @@ TEST_F(BraveStaticRedirectNetworkDelegateHelperTest, ModifySafeBrowsingURLV5) {
   EXPECT_EQ(ret, net::OK);
 }
 
+
+TEST_F(BraveStaticRedirectNetworkDelegateHelperTest,
+       ModifySafeBrowsingURLAnySchemeAndPath) {
+  net::TestDelegate test_delegate;
+  GURL url("http://safebrowsing.googleapis.com/safebrowsing/downloads");
+  std::unique_ptr<net::URLRequest> request =
+      context()->CreateRequest(url, net::IDLE, &test_delegate,
+                             TRAFFIC_ANNOTATION_FOR_TESTS);
+  std::shared_ptr<brave::BraveRequestInfo>
+      before_url_context(new brave::BraveRequestInfo());
+  brave::ResponseCallback callback;
+  GURL new_url;
+  GURL::Replacements replacements;
+  replacements.SetHostStr(SAFEBROWSING_ENDPOINT);
+  GURL expected_url(url.ReplaceComponents(replacements));
+  int ret =
+      OnBeforeURLRequest_StaticRedirectWork(request.get(), &new_url, callback,
+                                            before_url_context);
+  EXPECT_EQ(new_url, expected_url);
+  EXPECT_EQ(ret, net::OK);
+}
+
 }  // namespace
@@ -6,14 +6,18 @@
 
 #include "brave/browser/net/brave_static_redirect_network_delegate_helper.h"
 
+namespace {
+
+const brave::OnBeforeURLRequestCallback kBeforeURLRequestCallbacks[] = {
+  brave::OnBeforeURLRequest_StaticRedirectWork,
+};
+
+}  // namespace
 
 BraveSystemNetworkDelegate::BraveSystemNetworkDelegate(
     extensions::EventRouterForwarder* event_router) :
     BraveNetworkDelegateBase(event_router) {
-  brave::OnBeforeURLRequestCallback callback =
-      base::Bind(
-          brave::OnBeforeURLRequest_StaticRedirectWork);
-  before_url_request_callbacks_.push_back(callback);
+  before_url_request_callbacks_ = kBeforeURLRequestCallbacks;
 }
 
 BraveSystemNetworkDelegate::~BraveSystemNetworkDelegate() {
@@ -15,4 +15,17 @@ BraveRequestInfo::BraveRequestInfo() {
 BraveRequestInfo::~BraveRequestInfo() {
 }
 
+void BraveRequestInfo::Reset() {
+  request_url = GURL();
+  new_url_spec.clear();
+  request_identifier = 0;
+  next_url_request_index = 0;
+  request = nullptr;
+  new_url = nullptr;
+  headers = nullptr;
+  event_type = kUnknownEventType;
+  start_time = base::TimeTicks();
+  is_off_the_record = false;
+}
+
 }  // namespace brave
@@ -6,8 +6,10 @@
 #define BRAVE_BROWSER_NET_URL_CONTEXT_
 
 
+#include <memory>
 #include <string>
 
+#include "base/time/time.h"
 #include "chrome/browser/net/chrome_network_delegate.h"
 #include "url/gurl.h"
 
@@ -19,31 +21,47 @@ enum BraveNetworkDelegateEventType {
   kUnknownEventType
 };
 
+// State of one request going through the Brave network delegate chain. The
+// delegate reuses it for the next request unless a handler kept a reference,
+// so handlers must not assume a fresh object beyond what Reset() clears.
 struct BraveRequestInfo {
   BraveRequestInfo();
   ~BraveRequestInfo();
+  void Reset();
+
   GURL request_url;
   std::string new_url_spec;
   uint64_t request_identifier = 0;
   size_t next_url_request_index = 0;
+  net::URLRequest* request = nullptr;
+  GURL* new_url = nullptr;
   net::HttpRequestHeaders* headers = nullptr;
   BraveNetworkDelegateEventType event_type = kUnknownEventType;
+  // When the chain started, for the latency histograms.
+  base::TimeTicks start_time;
+  // Whether the request belongs to an off the record profile, in which case
+  // its URL must not outlive it, e.g. in the latency tracker.
+  bool is_off_the_record = false;
   DISALLOW_COPY_AND_ASSIGN(BraveRequestInfo);
 };
 
-using ResponseCallback = base::Callback<void()>;
+// Resumes the chain for |ctx| after a handler returned net::ERR_IO_PENDING.
+// The same callback is shared by every request of a delegate.
+using ResponseCallback =
+    base::Callback<void(std::shared_ptr<BraveRequestInfo> ctx)>;
 
-//ResponseListener
+// Handlers are plain functions listed in a fixed order by each delegate, so
+// running the chain does not bind or copy any callback.
 using OnBeforeURLRequestCallback =
-    base::Callback<int(net::URLRequest* request,
+    int (*)(net::URLRequest* request,
         GURL* new_url,
         const ResponseCallback& next_callback,
-        std::shared_ptr<BraveRequestInfo> ctx)>;
+        std::shared_ptr<BraveRequestInfo> ctx);
 using OnBeforeStartTransactionCallback =
-    base::Callback<int(net::URLRequest* request,
+    int (*)(net::URLRequest* request,
         net::HttpRequestHeaders* headers,
         const ResponseCallback& next_callback,
-        std::shared_ptr<BraveRequestInfo> ctx)>;
+        std::shared_ptr<BraveRequestInfo> ctx);
 }  // namespace brave
 
 
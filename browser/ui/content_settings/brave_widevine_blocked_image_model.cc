@@ -4,9 +4,9 @@
 
 #include "brave/browser/ui/content_settings/brave_widevine_blocked_image_model.h"
 
-#include "brave/common/pref_names.h"
-#include "brave/common/shield_exceptions.h"
 #include "brave/browser/ui/content_settings/brave_widevine_content_setting_bubble_model.h"
+#include "brave/common/pref_names.h"
+#include "brave/components/brave_shields/browser/shield_exceptions.h"
 #include "brave/grit/brave_generated_resources.h"
 #include "chrome/app/vector_icons/vector_icons.h"
 #include "chrome/browser/content_settings/host_content_settings_map_factory.h"
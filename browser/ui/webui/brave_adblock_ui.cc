@@ -5,13 +5,11 @@
 #include "brave/browser/ui/webui/brave_adblock_ui.h"
 
 #include "brave/browser/brave_browser_process_impl.h"
-#include "brave/common/pref_names.h"
 #include "brave/common/webui_url_constants.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service.h"
+#include "brave/components/brave_shields/browser/brave_shields_stats_service_factory.h"
 #include "chrome/browser/profiles/profile.h"
 #include "components/grit/brave_components_resources.h"
-#include "components/prefs/pref_change_registrar.h"
-#include "components/prefs/pref_service.h"
 #include "content/public/browser/render_frame_host.h"
 #include "content/public/browser/render_view_host.h"
 #include "content/public/browser/web_contents.h"
@@ -21,26 +19,29 @@
 
 BraveAdblockUI::BraveAdblockUI(content::WebUI* web_ui, const std::string& name)
     : BasicUI(web_ui, name, kAdblockJS,
-        IDR_BRAVE_ADBLOCK_JS, IDR_BRAVE_ADBLOCK_HTML) {
-  Profile* profile = Profile::FromWebUI(web_ui);
-  PrefService* prefs = profile->GetPrefs();
-  pref_change_registrar_ = std::make_unique<PrefChangeRegistrar>();
-  pref_change_registrar_->Init(prefs);
-  pref_change_registrar_->Add(kAdsBlocked,
-    base::Bind(&BraveAdblockUI::OnPreferenceChanged, base::Unretained(this)));
+        IDR_BRAVE_ADBLOCK_JS, IDR_BRAVE_ADBLOCK_HTML),
+      stats_service_(brave_shields::BraveShieldsStatsServiceFactory::
+          GetForProfile(Profile::FromWebUI(web_ui))) {
+  if (stats_service_) {
+    stats_service_->AddObserver(this);
+  }
 }
 
 BraveAdblockUI::~BraveAdblockUI() {
+  if (stats_service_) {
+    stats_service_->RemoveObserver(this);
+  }
 }
 
 void BraveAdblockUI::CustomizeWebUIProperties() {
-  Profile* profile = Profile::FromWebUI(web_ui());
-  PrefService* prefs = profile->GetPrefs();
   auto* web_contents = web_ui()->GetWebContents();
   if (web_contents) {
     auto* render_view_host = web_contents->GetRenderViewHost();
     if (render_view_host) {
-      render_view_host->SetWebUIProperty("adsBlockedStat", std::to_string(prefs->GetUint64(kAdsBlocked)));
+      const uint64_t ads_blocked = stats_service_ ?
+          stats_service_->GetTotal(brave_shields::BlockedStat::kAds) : 0;
+      render_view_host->SetWebUIProperty("adsBlockedStat",
+                                         std::to_string(ads_blocked));
       render_view_host->SetWebUIProperty("regionalAdBlockEnabled",
           std::to_string(
             g_brave_browser_process->ad_block_regional_service()->IsInitialized()));
@@ -56,7 +57,7 @@ void BraveAdblockUI::RenderFrameCreated(content::RenderFrameHost* render_frame_h
   }
 }
 
-void BraveAdblockUI::OnPreferenceChanged() {
+void BraveAdblockUI::OnShieldsStatsChanged() {
   if (0 != (web_ui()->GetBindings() & content::BINDINGS_POLICY_WEB_UI)) {
     CustomizeWebUIProperties();
     web_ui()->CallJavascriptFunctionUnsafe("brave_adblock.statsUpdated");
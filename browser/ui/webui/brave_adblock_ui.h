@@ -5,12 +5,12 @@
 #ifndef BRAVE_BROWSER_UI_WEBUI_BRAVE_ADBLOCK_UI_H_
 #define BRAVE_BROWSER_UI_WEBUI_BRAVE_ADBLOCK_UI_H_
 
-#include <memory>
 #include "brave/browser/ui/webui/basic_ui.h"
+#include "brave/components/brave_shields/browser/brave_shields_stats_service.h"
 
-class PrefChangeRegistrar;
-
-class BraveAdblockUI : public BasicUI {
+class BraveAdblockUI
+    : public BasicUI,
+      public brave_shields::BraveShieldsStatsService::Observer {
  public:
   BraveAdblockUI(content::WebUI* web_ui, const std::string& host);
   ~BraveAdblockUI() override;
@@ -18,9 +18,11 @@ class BraveAdblockUI : public BasicUI {
  private:
   void CustomizeWebUIProperties();
   void RenderFrameCreated(content::RenderFrameHost* render_frame_host) override;
-  void OnPreferenceChanged();
 
-  std::unique_ptr<PrefChangeRegistrar> pref_change_registrar_;
+  // brave_shields::BraveShieldsStatsService::Observer:
+  void OnShieldsStatsChanged() override;
+
+  brave_shields::BraveShieldsStatsService* stats_service_;
 
   DISALLOW_COPY_AND_ASSIGN(BraveAdblockUI);
 };
@@ -7,9 +7,9 @@
 #include "brave/browser/alternate_private_search_engine_util.h"
 #include "brave/common/pref_names.h"
 #include "brave/common/webui_url_constants.h"
+#include "brave/components/brave_shields/browser/brave_shields_stats_service_factory.h"
 #include "chrome/browser/profiles/profile.h"
 #include "components/grit/brave_components_resources.h"
-#include "components/prefs/pref_change_registrar.h"
 #include "components/prefs/pref_service.h"
 #include "content/public/browser/render_frame_host.h"
 #include "content/public/browser/render_view_host.h"
@@ -41,26 +41,31 @@ class NewTabDOMHandler : public content::WebUIMessageHandler {
   DISALLOW_COPY_AND_ASSIGN(NewTabDOMHandler);
 };
 
+uint64_t GetStat(const brave_shields::BraveShieldsStatsService* stats_service,
+                 brave_shields::BlockedStat stat) {
+  return stats_service ? stats_service->GetTotal(stat) : 0;
+}
+
 }  // namespace
 
 BraveNewTabUI::BraveNewTabUI(content::WebUI* web_ui, const std::string& name)
     : BasicUI(web_ui, name, kBraveNewTabJS,
-        IDR_BRAVE_NEW_TAB_JS, IDR_BRAVE_NEW_TAB_HTML) {
-  Profile* profile = Profile::FromWebUI(web_ui);
-  PrefService* prefs = profile->GetPrefs();
-  pref_change_registrar_ = std::make_unique<PrefChangeRegistrar>();
-  pref_change_registrar_->Init(prefs);
-  pref_change_registrar_->Add(kAdsBlocked,
-    base::Bind(&BraveNewTabUI::OnPreferenceChanged, base::Unretained(this)));
-  pref_change_registrar_->Add(kTrackersBlocked,
-    base::Bind(&BraveNewTabUI::OnPreferenceChanged, base::Unretained(this)));
-  pref_change_registrar_->Add(kHttpsUpgrades,
-    base::Bind(&BraveNewTabUI::OnPreferenceChanged, base::Unretained(this)));
+        IDR_BRAVE_NEW_TAB_JS, IDR_BRAVE_NEW_TAB_HTML),
+      stats_service_(brave_shields::BraveShieldsStatsServiceFactory::
+          GetForProfile(Profile::FromWebUI(web_ui))) {
+  // The service throttles its notifications, so the page is not updated on
+  // every blocked request.
+  if (stats_service_) {
+    stats_service_->AddObserver(this);
+  }
 
   web_ui->AddMessageHandler(std::make_unique<NewTabDOMHandler>());
 }
 
 BraveNewTabUI::~BraveNewTabUI() {
+  if (stats_service_) {
+    stats_service_->RemoveObserver(this);
+  }
 }
 
 void BraveNewTabUI::CustomizeNewTabWebUIProperties() {
@@ -72,19 +77,24 @@ void BraveNewTabUI::CustomizeNewTabWebUIProperties() {
     if (render_view_host) {
       render_view_host->SetWebUIProperty(
           "adsBlockedStat",
-          std::to_string(prefs->GetUint64(kAdsBlocked)));
+          std::to_string(GetStat(stats_service_,
+                                 brave_shields::BlockedStat::kAds)));
       render_view_host->SetWebUIProperty(
           "trackersBlockedStat",
-          std::to_string(prefs->GetUint64(kTrackersBlocked)));
+          std::to_string(GetStat(stats_service_,
+                                 brave_shields::BlockedStat::kTrackers)));
       render_view_host->SetWebUIProperty(
           "javascriptBlockedStat",
-          std::to_string(prefs->GetUint64(kJavascriptBlocked)));
+          std::to_string(GetStat(stats_service_,
+                                 brave_shields::BlockedStat::kJavascript)));
       render_view_host->SetWebUIProperty(
           "httpsUpgradesStat",
-          std::to_string(prefs->GetUint64(kHttpsUpgrades)));
+          std::to_string(GetStat(stats_service_,
+                                 brave_shields::BlockedStat::kHttpsUpgrades)));
       render_view_host->SetWebUIProperty(
           "fingerprintingBlockedStat",
-          std::to_string(prefs->GetUint64(kFingerprintingBlocked)));
+          std::to_string(GetStat(stats_service_,
+                                 brave_shields::BlockedStat::kFingerprinting)));
       render_view_host->SetWebUIProperty(
           "useAlternativePrivateSearchEngine",
           prefs->GetBoolean(kUseAlternatePrivateSearchEngine) ? "true"
@@ -99,7 +109,7 @@ void BraveNewTabUI::RenderFrameCreated(content::RenderFrameHost* render_frame_ho
   }
 }
 
-void BraveNewTabUI::OnPreferenceChanged() {
+void BraveNewTabUI::OnShieldsStatsChanged() {
   if (0 != (web_ui()->GetBindings() & content::BINDINGS_POLICY_WEB_UI)) {
     CustomizeNewTabWebUIProperties();
     web_ui()->CallJavascriptFunctionUnsafe("brave_new_tab.statsUpdated");
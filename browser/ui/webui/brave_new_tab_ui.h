@@ -5,12 +5,11 @@
 #ifndef BRAVE_BROWSER_UI_WEBUI_BRAVE_NEW_TAB_UI_H_
 #define BRAVE_BROWSER_UI_WEBUI_BRAVE_NEW_TAB_UI_H_
 
-#include <memory>
 #include "brave/browser/ui/webui/basic_ui.h"
+#include "brave/components/brave_shields/browser/brave_shields_stats_service.h"
 
-class PrefChangeRegistrar;
-
-class BraveNewTabUI : public BasicUI {
+class BraveNewTabUI : public BasicUI,
+                      public brave_shields::BraveShieldsStatsService::Observer {
  public:
   BraveNewTabUI(content::WebUI* web_ui, const std::string& host);
   ~BraveNewTabUI() override;
@@ -18,9 +17,11 @@ class BraveNewTabUI : public BasicUI {
  private:
   void CustomizeNewTabWebUIProperties();
   void RenderFrameCreated(content::RenderFrameHost* render_frame_host) override;
-  void OnPreferenceChanged();
 
-  std::unique_ptr<PrefChangeRegistrar> pref_change_registrar_;
+  // brave_shields::BraveShieldsStatsService::Observer:
+  void OnShieldsStatsChanged() override;
+
+  brave_shields::BraveShieldsStatsService* stats_service_;
 
   DISALLOW_COPY_AND_ASSIGN(BraveNewTabUI);
 };
@@ -0,0 +1,154 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/ui/webui/brave_shields_internals_ui.h"
+
+#include <memory>
+#include <string>
+
+#include "base/memory/ref_counted_memory.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
+#include "brave/browser/brave_browser_process_impl.h"
+#include "brave/common/webui_url_constants.h"
+#include "brave/components/brave_shields/browser/https_everywhere_service.h"
+#include "brave/components/brave_shields/browser/shields_latency_tracker.h"
+#include "brave/components/content_settings/core/browser/brave_cookie_settings.h"
+#include "chrome/browser/content_settings/cookie_settings_factory.h"
+#include "chrome/browser/profiles/profile.h"
+#include "content/public/browser/url_data_source.h"
+#include "content/public/browser/web_ui.h"
+#include "net/base/escape.h"
+
+using brave_shields::ShieldsLatencyTracker;
+using content_settings::BraveCookieDecisionCacheStats;
+using content_settings::BraveCookieSettings;
+
+namespace {
+
+std::string FormatLatency(base::TimeDelta latency) {
+  return base::StringPrintf("%.3f ms", latency.InMicrosecondsF() / 1000);
+}
+
+std::string RenderStagesTable() {
+  std::string html =
+      "<h2>Stages</h2><table><tr><th>Stage</th><th>Samples</th>"
+      "<th>p50</th><th>p99</th><th>Max</th><th>Cache hits</th>"
+      "<th>Cache misses</th></tr>";
+  for (const auto& summary :
+       ShieldsLatencyTracker::GetInstance()->GetStageSummaries()) {
+    html += base::StringPrintf(
+        "<tr><td>%s</td><td>%zu</td><td>%s</td><td>%s</td><td>%s</td>"
+        "<td>%s</td><td>%s</td></tr>",
+        summary.name, summary.sample_count,
+        FormatLatency(summary.p50).c_str(),
+        FormatLatency(summary.p99).c_str(),
+        FormatLatency(summary.max).c_str(),
+        base::NumberToString(summary.cache_hits).c_str(),
+        base::NumberToString(summary.cache_misses).c_str());
+  }
+  html += "</table>";
+  return html;
+}
+
+std::string RenderSlowestRequestsTable() {
+  std::string html =
+      "<h2>Slowest requests</h2><table><tr><th>Duration</th><th>Stage</th>"
+      "<th>URL</th></tr>";
+  for (const auto& request :
+       ShieldsLatencyTracker::GetInstance()->GetSlowestRequests()) {
+    html += base::StringPrintf(
+        "<tr><td>%s</td><td>%s</td><td>%s</td></tr>",
+        FormatLatency(request.duration).c_str(),
+        ShieldsLatencyTracker::GetStageName(request.stage),
+        request.url.empty() ? "(off the record)" :
+            net::EscapeForHTML(request.url).c_str());
+  }
+  html += "</table>";
+  return html;
+}
+
+std::string RenderHTTPSECacheTable() {
+  ShardedLRUCacheStats stats =
+      g_brave_browser_process->https_everywhere_service()->
+          GetRecentlyUsedCacheStats();
+  return base::StringPrintf(
+      "<h2>HTTPS Everywhere URL cache</h2><table>"
+      "<tr><th>Hits</th><th>Misses</th><th>Evictions</th><th>Size</th></tr>"
+      "<tr><td>%s</td><td>%s</td><td>%s</td><td>%zu / %zu</td></tr>"
+      "</table>",
+      base::NumberToString(stats.hits).c_str(),
+      base::NumberToString(stats.misses).c_str(),
+      base::NumberToString(stats.evictions).c_str(),
+      stats.size, stats.capacity);
+}
+
+std::string RenderCookieDecisionCacheTable(Profile* profile) {
+  scoped_refptr<content_settings::CookieSettings> cookie_settings =
+      CookieSettingsFactory::GetForProfile(profile);
+  BraveCookieDecisionCacheStats stats =
+      static_cast<BraveCookieSettings*>(cookie_settings.get())->
+          GetDecisionCacheStats();
+  return base::StringPrintf(
+      "<h2>Cookie decision cache</h2><table>"
+      "<tr><th>Hits</th><th>Misses</th><th>Size</th></tr>"
+      "<tr><td>%s</td><td>%s</td><td>%zu</td></tr>"
+      "</table>",
+      base::NumberToString(stats.hits).c_str(),
+      base::NumberToString(stats.misses).c_str(),
+      stats.size);
+}
+
+class ShieldsInternalsSource : public content::URLDataSource {
+ public:
+  explicit ShieldsInternalsSource(Profile* profile) : profile_(profile) {}
+  ~ShieldsInternalsSource() override {}
+
+  // content::URLDataSource:
+  std::string GetSource() const override {
+    return kShieldsInternalsHost;
+  }
+
+  void StartDataRequest(
+      const std::string& path,
+      const content::ResourceRequestInfo::WebContentsGetter& wc_getter,
+      const content::URLDataSource::GotDataCallback& callback) override {
+    std::string html =
+        "<!doctype html><html><head><meta charset=\"utf-8\">"
+        "<title>Shields internals</title>"
+        "<style>table{border-collapse:collapse}"
+        "td,th{border:1px solid #ccc;padding:2px 8px;text-align:left}"
+        "</style></head><body><h1>Shields internals</h1>"
+        "<p>Latencies of the most recent requests per stage. Also reported "
+        "as the Brave.Shields.Latency.* histograms and traced in the "
+        "disabled-by-default-brave.shields category.</p>";
+    html += RenderStagesTable();
+    html += RenderHTTPSECacheTable();
+    html += RenderCookieDecisionCacheTable(profile_);
+    html += RenderSlowestRequestsTable();
+    html += "</body></html>";
+    callback.Run(base::RefCountedString::TakeString(&html));
+  }
+
+  std::string GetMimeType(const std::string& path) const override {
+    return "text/html";
+  }
+
+ private:
+  Profile* profile_;
+
+  DISALLOW_COPY_AND_ASSIGN(ShieldsInternalsSource);
+};
+
+}  // namespace
+
+BraveShieldsInternalsUI::BraveShieldsInternalsUI(content::WebUI* web_ui)
+    : WebUIController(web_ui) {
+  Profile* profile = Profile::FromWebUI(web_ui);
+  content::URLDataSource::Add(
+      profile, std::make_unique<ShieldsInternalsSource>(profile));
+}
+
+BraveShieldsInternalsUI::~BraveShieldsInternalsUI() {
+}
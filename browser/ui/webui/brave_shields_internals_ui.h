@@ -0,0 +1,23 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_BROWSER_UI_WEBUI_BRAVE_SHIELDS_INTERNALS_UI_H_
+#define BRAVE_BROWSER_UI_WEBUI_BRAVE_SHIELDS_INTERNALS_UI_H_
+
+#include "base/macros.h"
+#include "content/public/browser/web_ui_controller.h"
+
+// chrome://shields-internals, showing how long each stage of the shields
+// request path takes and the slowest recent requests. The page is rendered
+// on each load, reload it to refresh.
+class BraveShieldsInternalsUI : public content::WebUIController {
+ public:
+  explicit BraveShieldsInternalsUI(content::WebUI* web_ui);
+  ~BraveShieldsInternalsUI() override;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(BraveShieldsInternalsUI);
+};
+
+#endif  // BRAVE_BROWSER_UI_WEBUI_BRAVE_SHIELDS_INTERNALS_UI_H_
@@ -0,0 +1,16 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/renderer/brave_content_settings_observer.h"
+#include "chrome/renderer/chrome_render_thread_observer.h"
+
+#define SetContentSettingRules SetContentSettingRules_ChromiumImpl
+#include "../../../../chrome/renderer/chrome_render_thread_observer.cc"
+#undef SetContentSettingRules
+
+void ChromeRenderThreadObserver::SetContentSettingRules(
+    const RendererContentSettingRules& rules) {
+  SetContentSettingRules_ChromiumImpl(rules);
+  BraveContentSettingsObserver::OnContentSettingRulesUpdated(rules);
+}
@@ -0,0 +1,21 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_CHROMIUM_SRC_CHROME_RENDERER_CHROME_RENDER_THREAD_OBSERVER_H_
+#define BRAVE_CHROMIUM_SRC_CHROME_RENDERER_CHROME_RENDER_THREAD_OBSERVER_H_
+
+// Included ahead of the define so that the interface method keeps its name.
+#include "chrome/common/renderer_configuration.mojom.h"
+
+// Keeps Chromium's SetContentSettingRules as
+// SetContentSettingRules_ChromiumImpl and declares a replacement, which is
+// defined in the matching .cc.
+#define SetContentSettingRules                              \
+  SetContentSettingRules_ChromiumImpl(                      \
+      const RendererContentSettingRules& rules);            \
+  void SetContentSettingRules
+#include "../../../../chrome/renderer/chrome_render_thread_observer.h"
+#undef SetContentSettingRules
+
+#endif  // BRAVE_CHROMIUM_SRC_CHROME_RENDERER_CHROME_RENDER_THREAD_OBSERVER_H_
@@ -5,15 +5,6 @@ extern const char kBraveUpdatesExtensionsEndpoint[];
 
 extern const char kEmptyDataURI[];
 extern const char kJSDataURLPrefix[];
-extern const char kGeoLocationsPattern[];
-extern const char kGoogleTagManagerPattern[];
-extern const char kGoogleTagServicesPattern[];
-extern const char kForbesPattern[];
-extern const char kForbesExtraCookies[];
-extern const char kSafeBrowsingPrefix[];
-extern const char kTwitterPattern[];
-extern const char kTwitterReferrer[];
-extern const char kTwitterRedirectURL[];
 
 extern const char kCookieHeader[];
 extern const char kRefererHeader[];
@@ -11,6 +11,7 @@ const char kRewardsJS[] = "brave_rewards.js";
 const char kWelcomeHost[] = "welcome";
 const char kWelcomeJS[] = "brave_welcome.js";
 const char kBraveNewTabJS[] = "brave_new_tab.js";
+const char kShieldsInternalsHost[] = "shields-internals";
 const char kBraveUIWelcomeURL[] = "chrome://welcome/";
 const char kBraveUIRewardsURL[] = "chrome://rewards/";
 const char kBraveUIAdblockURL[] = "chrome://adblock/";
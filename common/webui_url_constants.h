@@ -8,6 +8,7 @@ extern const char kRewardsJS[];
 extern const char kWelcomeHost[];
 extern const char kWelcomeJS[];
 extern const char kBraveNewTabJS[];
+extern const char kShieldsInternalsHost[];
 extern const char kBraveUIWelcomeURL[];
 extern const char kBraveUIRewardsURL[];
 extern const char kBraveUIAdblockURL[];
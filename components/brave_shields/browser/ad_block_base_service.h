@@ -12,15 +12,17 @@
 #include <vector>
 
 #include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
+#include "base/synchronization/lock.h"
 #include "brave/components/brave_shields/browser/base_brave_shields_service.h"
 #include "brave/components/brave_shields/browser/dat_file_util.h"
 #include "content/public/common/resource_type.h"
 
-class AdBlockClient;
-
 namespace brave_shields {
 
+class AdBlockEngine;
+
 // The base class of the brave shields service in charge of ad-block
 // checking and init.
 class AdBlockBaseService : public BaseBraveShieldsService {
@@ -36,13 +38,21 @@ class AdBlockBaseService : public BaseBraveShieldsService {
   bool Init() override;
   void Cleanup() override;
 
+  // Loads and deserializes the list on the task runner, then swaps it in.
   void GetDATFileData(const base::FilePath& dat_file_path);
-
-  std::unique_ptr<AdBlockClient> ad_block_client_;
-  DATFileDataBuffer buffer_;
+  // Returns the current engine, or nullptr if no list is loaded yet. Callers
+  // keep using the snapshot even if a newer list is published meanwhile.
+  scoped_refptr<AdBlockEngine> GetEngine() const;
+  // Called on the owning thread after a new engine has been published.
+  virtual void OnEngineChanged(scoped_refptr<AdBlockEngine> engine) {}
 
  private:
-  void OnDATFileDataReady();
+  void OnEngineReady(scoped_refptr<AdBlockEngine> engine);
+
+  // Guards |engine_|, which is swapped on the owning thread and read on the
+  // IO thread.
+  mutable base::Lock engine_lock_;
+  scoped_refptr<AdBlockEngine> engine_;
 
   base::WeakPtrFactory<AdBlockBaseService> weak_factory_;
 
@@ -0,0 +1,168 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_engine.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/files/memory_mapped_file.h"
+#include "base/logging.h"
+#include "base/threading/thread_restrictions.h"
+#include "brave/vendor/ad-block/ad_block_client.h"
+#include "url/gurl.h"
+
+namespace {
+
+FilterOption ResourceTypeToFilterOption(content::ResourceType resource_type) {
+  FilterOption filter_option = FONoFilterOption;
+  switch(resource_type) {
+    // top level page
+    case content::RESOURCE_TYPE_MAIN_FRAME:
+      filter_option = FODocument;
+      break;
+    // frame or iframe
+    case content::RESOURCE_TYPE_SUB_FRAME:
+      filter_option = FOSubdocument;
+      break;
+    // a CSS stylesheet
+    case content::RESOURCE_TYPE_STYLESHEET:
+      filter_option = FOStylesheet;
+      break;
+    // an external script
+    case content::RESOURCE_TYPE_SCRIPT:
+      filter_option = FOScript;
+      break;
+    // an image (jpg/gif/png/etc)
+    case content::RESOURCE_TYPE_IMAGE:
+      filter_option = FOImage;
+      break;
+    // a font
+    case content::RESOURCE_TYPE_FONT_RESOURCE:
+      filter_option = FOFont;
+      break;
+    // an "other" subresource.
+    case content::RESOURCE_TYPE_SUB_RESOURCE:
+      filter_option = FOOther;
+      break;
+    // an object (or embed) tag for a plugin.
+    case content::RESOURCE_TYPE_OBJECT:
+      filter_option = FOObject;
+      break;
+    // a media resource.
+    case content::RESOURCE_TYPE_MEDIA:
+      filter_option = FOMedia;
+      break;
+    // a XMLHttpRequest
+    case content::RESOURCE_TYPE_XHR:
+      filter_option = FOXmlHttpRequest;
+      break;
+    // a ping request for <a ping>/sendBeacon.
+    case content::RESOURCE_TYPE_PING:
+      filter_option = FOPing;
+      break;
+    // the main resource of a dedicated
+    case content::RESOURCE_TYPE_WORKER:
+    // the main resource of a shared worker.
+    case content::RESOURCE_TYPE_SHARED_WORKER:
+    // an explicitly requested prefetch
+    case content::RESOURCE_TYPE_PREFETCH:
+    // a favicon
+    case content::RESOURCE_TYPE_FAVICON:
+    // the main resource of a service worker.
+    case content::RESOURCE_TYPE_SERVICE_WORKER:
+    // a report of Content Security Policy
+    case content::RESOURCE_TYPE_CSP_REPORT:
+    // a resource that a plugin requested.
+    case content::RESOURCE_TYPE_PLUGIN_RESOURCE:
+    case content::RESOURCE_TYPE_LAST_TYPE:
+    default:
+      break;
+  }
+  return filter_option;
+}
+
+}  // namespace
+
+namespace brave_shields {
+
+AdBlockEngine::AdBlockEngine() {
+}
+
+AdBlockEngine::~AdBlockEngine() {
+}
+
+// static
+scoped_refptr<AdBlockEngine> AdBlockEngine::Create(
+    std::unique_ptr<DATFileData> dat_file_data) {
+  base::AssertBlockingAllowed();
+  if (!dat_file_data) {
+    return nullptr;
+  }
+  scoped_refptr<AdBlockEngine> engine(new AdBlockEngine());
+  engine->dat_file_data_ = std::move(dat_file_data);
+  engine->ad_block_client_.reset(new AdBlockClient());
+  if (!engine->ad_block_client_->deserialize(
+          GetDATFileDataPointer(engine->dat_file_data_.get()))) {
+    LOG(ERROR) << "Failed to deserialize ad block data";
+    return nullptr;
+  }
+  return engine;
+}
+
+bool AdBlockEngine::Matches(const GURL& url,
+                            content::ResourceType resource_type,
+                            const std::string& tab_host) {
+  return ad_block_client_->matches(url.spec().c_str(),
+                                   ResourceTypeToFilterOption(resource_type),
+                                   tab_host.c_str());
+}
+
+AdBlockEngineSet::AdBlockEngineSet() {
+}
+
+AdBlockEngineSet::~AdBlockEngineSet() {
+}
+
+scoped_refptr<AdBlockEngineSet> AdBlockEngineSet::CloneWithEngine(
+    AdBlockListSource source,
+    scoped_refptr<AdBlockEngine> engine) const {
+  scoped_refptr<AdBlockEngineSet> engine_set(new AdBlockEngineSet());
+  for (const Entry& entry : engines_) {
+    if (entry.source != source) {
+      engine_set->engines_.push_back(entry);
+    }
+  }
+  if (engine) {
+    engine_set->engines_.push_back({source, std::move(engine)});
+  }
+  std::sort(engine_set->engines_.begin(), engine_set->engines_.end(),
+            [](const Entry& a, const Entry& b) {
+              return a.source < b.source;
+            });
+  return engine_set;
+}
+
+bool AdBlockEngineSet::Matches(const GURL& url,
+                               content::ResourceType resource_type,
+                               const std::string& tab_host,
+                               AdBlockListSource* source) const {
+  if (engines_.empty()) {
+    return false;
+  }
+  const char* spec = url.spec().c_str();
+  FilterOption current_option = ResourceTypeToFilterOption(resource_type);
+  for (const Entry& entry : engines_) {
+    if (entry.engine->ad_block_client_->matches(spec, current_option,
+                                                tab_host.c_str())) {
+      if (source) {
+        *source = entry.source;
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,101 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_ENGINE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_ENGINE_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "brave/components/brave_shields/browser/dat_file_util.h"
+#include "content/public/common/resource_type.h"
+
+class AdBlockClient;
+class GURL;
+
+namespace brave_shields {
+
+// The list an ad-block engine was built from, in matching order.
+enum class AdBlockListSource {
+  kDefault,
+  kRegional,
+};
+
+// A deserialized ad-block list together with the DAT data it points into.
+// Engines are built on the service task runner and then published as a
+// whole, so a list update never touches an engine requests are matched
+// against.
+class AdBlockEngine : public base::RefCountedThreadSafe<AdBlockEngine> {
+ public:
+  // Deserializes |dat_file_data|. Returns nullptr if it does not hold a valid
+  // ad-block list. Must be called where blocking is allowed since it pages
+  // the mapping in.
+  static scoped_refptr<AdBlockEngine> Create(
+      std::unique_ptr<DATFileData> dat_file_data);
+
+  // Returns true if a request for |url| made from |tab_host| should be
+  // blocked. AdBlockClient keeps match statistics, so this is not const and
+  // must only be called from one thread at a time.
+  bool Matches(const GURL& url,
+               content::ResourceType resource_type,
+               const std::string& tab_host);
+
+ private:
+  friend class base::RefCountedThreadSafe<AdBlockEngine>;
+  friend class AdBlockEngineSet;
+
+  AdBlockEngine();
+  ~AdBlockEngine();
+
+  std::unique_ptr<DATFileData> dat_file_data_;
+  // Points into |dat_file_data_|, so it is declared after it.
+  std::unique_ptr<AdBlockClient> ad_block_client_;
+
+  DISALLOW_COPY_AND_ASSIGN(AdBlockEngine);
+};
+
+// An immutable set of engines, one per list, matched in a single pass: the
+// URL spec and the filter option are computed once for all of them. A new
+// set is published whenever one of its lists is updated.
+class AdBlockEngineSet : public base::RefCountedThreadSafe<AdBlockEngineSet> {
+ public:
+  AdBlockEngineSet();
+
+  // Returns a copy of this set where the engine for |source| is replaced by
+  // |engine|, or removed if |engine| is nullptr.
+  scoped_refptr<AdBlockEngineSet> CloneWithEngine(
+      AdBlockListSource source,
+      scoped_refptr<AdBlockEngine> engine) const;
+
+  // Returns true if any list blocks the request, and then sets |source| to the
+  // first list that did. |source| may be nullptr.
+  bool Matches(const GURL& url,
+               content::ResourceType resource_type,
+               const std::string& tab_host,
+               AdBlockListSource* source) const;
+
+  bool empty() const { return engines_.empty(); }
+
+ private:
+  friend class base::RefCountedThreadSafe<AdBlockEngineSet>;
+
+  struct Entry {
+    AdBlockListSource source;
+    scoped_refptr<AdBlockEngine> engine;
+  };
+
+  ~AdBlockEngineSet();
+
+  // Sorted by source.
+  std::vector<Entry> engines_;
+
+  DISALLOW_COPY_AND_ASSIGN(AdBlockEngineSet);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_ENGINE_H_
@@ -19,6 +19,8 @@
 #include "base/threading/thread_restrictions.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/common/pref_names.h"
+#include "brave/components/brave_shields/browser/ad_block_engine.h"
+#include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/vendor/ad-block/ad_block_client.h"
 #include "brave/vendor/ad-block/data_file_version.h"
 #include "brave/vendor/ad-block/lists/regions.h"
@@ -116,6 +118,14 @@ void AdBlockRegionalService::OnComponentReady(
   AdBlockBaseService::GetDATFileData(dat_file_path);
 }
 
+void AdBlockRegionalService::OnEngineChanged(
+    scoped_refptr<AdBlockEngine> engine) {
+  // Matched together with the default list, see
+  // AdBlockService::ShouldStartRequestForAllLists.
+  g_brave_browser_process->ad_block_service()->SetListEngine(
+      AdBlockListSource::kRegional, std::move(engine));
+}
+
 // static
 bool AdBlockRegionalService::IsSupportedLocale(const std::string& locale) {
   return (FindFilterListByLocale(locale) != region_lists.end());
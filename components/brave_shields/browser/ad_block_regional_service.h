@@ -39,6 +39,7 @@ class AdBlockRegionalService : public AdBlockBaseService {
   void OnComponentRegistered(const std::string& component_id) override;
   void OnComponentReady(const std::string& component_id,
                         const base::FilePath& install_dir) override;
+  void OnEngineChanged(scoped_refptr<AdBlockEngine> engine) override;
 
  private:
   friend class ::AdBlockServiceTest;
@@ -16,6 +16,7 @@
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/threading/thread_restrictions.h"
+#include "brave/components/brave_shields/browser/ad_block_engine.h"
 #include "brave/vendor/ad-block/ad_block_client.h"
 #include "brave/vendor/ad-block/data_file_version.h"
 
@@ -30,7 +31,8 @@ std::string AdBlockService::g_ad_block_component_base64_public_key_(
 std::string AdBlockService::g_ad_block_dat_file_version_(
     base::NumberToString(DATA_FILE_VERSION));
 
-AdBlockService::AdBlockService() {
+AdBlockService::AdBlockService()
+    : engine_set_(new AdBlockEngineSet()) {
 }
 
 AdBlockService::~AdBlockService() {
@@ -42,6 +44,28 @@ bool AdBlockService::ShouldStartRequest(const GURL& url,
   return AdBlockBaseService::ShouldStartRequest(url, resource_type, tab_host);
 }
 
+bool AdBlockService::ShouldStartRequestForAllLists(const GURL& url,
+    content::ResourceType resource_type,
+    const std::string& tab_host,
+    AdBlockListSource* source) {
+  scoped_refptr<AdBlockEngineSet> engine_set;
+  {
+    base::AutoLock lock(engine_set_lock_);
+    engine_set = engine_set_;
+  }
+  return !engine_set->Matches(url, resource_type, tab_host, source);
+}
+
+void AdBlockService::SetListEngine(AdBlockListSource source,
+                                   scoped_refptr<AdBlockEngine> engine) {
+  base::AutoLock lock(engine_set_lock_);
+  engine_set_ = engine_set_->CloneWithEngine(source, std::move(engine));
+}
+
+void AdBlockService::OnEngineChanged(scoped_refptr<AdBlockEngine> engine) {
+  SetListEngine(AdBlockListSource::kDefault, std::move(engine));
+}
+
 bool AdBlockService::Init() {
   Register(kAdBlockComponentName, g_ad_block_component_id_,
            g_ad_block_component_base64_public_key_);
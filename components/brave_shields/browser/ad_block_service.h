@@ -11,7 +11,10 @@
 #include <string>
 #include <vector>
 
+#include "base/memory/ref_counted.h"
+#include "base/synchronization/lock.h"
 #include "brave/components/brave_shields/browser/ad_block_base_service.h"
+#include "brave/components/brave_shields/browser/ad_block_engine.h"
 #include "content/public/common/resource_type.h"
 
 class AdBlockClient;
@@ -40,11 +43,23 @@ class AdBlockService : public AdBlockBaseService {
   bool ShouldStartRequest(const GURL &url,
     content::ResourceType resource_type,
     const std::string& tab_host) override;
+  // Matches against the default list and every list registered through
+  // SetListEngine in a single pass. When the request is blocked |source| is
+  // set to the list that matched; it may be nullptr.
+  bool ShouldStartRequestForAllLists(const GURL& url,
+    content::ResourceType resource_type,
+    const std::string& tab_host,
+    AdBlockListSource* source);
+  // Replaces the engine used for |source| by ShouldStartRequestForAllLists,
+  // or removes it if |engine| is nullptr.
+  void SetListEngine(AdBlockListSource source,
+                     scoped_refptr<AdBlockEngine> engine);
 
  protected:
   bool Init() override;
   void OnComponentReady(const std::string& component_id,
                         const base::FilePath& install_dir) override;
+  void OnEngineChanged(scoped_refptr<AdBlockEngine> engine) override;
 
  private:
   friend class ::AdBlockServiceTest;
@@ -56,6 +71,11 @@ class AdBlockService : public AdBlockBaseService {
       const std::string& component_base64_public_key);
   static void SetDATFileVersionForTest(const std::string& dat_file_version);
 
+  // Guards |engine_set_|, which is replaced on the owning thread and read on
+  // the IO thread.
+  base::Lock engine_set_lock_;
+  scoped_refptr<AdBlockEngineSet> engine_set_;
+
   DISALLOW_COPY_AND_ASSIGN(AdBlockService);
 };
 
@@ -0,0 +1,99 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/blocked_event_batcher.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/lazy_instance.h"
+#include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
+#include "content/public/browser/browser_thread.h"
+
+using content::BrowserThread;
+
+namespace {
+
+// Short enough for the shields panel to look live.
+const int kFlushDelayMs = 200;
+// A tab is flushed early past this many events so its batch stays small.
+const size_t kMaxPendingEvents = 100;
+
+base::LazyInstance<brave_shields::BlockedEventBatcher>::Leaky
+    g_blocked_event_batcher = LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
+namespace brave_shields {
+
+BlockedEvent::BlockedEvent()
+    : render_process_id(-1),
+      render_frame_id(-1),
+      frame_tree_node_id(-1),
+      tab_frame_tree_node_id(-1),
+      navigation_id(0) {
+}
+
+BlockedEvent::BlockedEvent(const BlockedEvent& other) = default;
+
+BlockedEvent::~BlockedEvent() {
+}
+
+// static
+BlockedEventBatcher* BlockedEventBatcher::GetInstance() {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  return g_blocked_event_batcher.Pointer();
+}
+
+BlockedEventBatcher::BlockedEventBatcher() {
+}
+
+BlockedEventBatcher::~BlockedEventBatcher() {
+}
+
+void BlockedEventBatcher::Add(const BlockedEvent& event) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  std::vector<BlockedEvent>& tab_events =
+      pending_events_[event.tab_frame_tree_node_id];
+  tab_events.push_back(event);
+  if (tab_events.size() >= kMaxPendingEvents) {
+    FlushTab(event.tab_frame_tree_node_id);
+    return;
+  }
+  if (!flush_timer_.IsRunning()) {
+    flush_timer_.Start(FROM_HERE,
+        base::TimeDelta::FromMilliseconds(kFlushDelayMs),
+        base::Bind(&BlockedEventBatcher::Flush, base::Unretained(this)));
+  }
+}
+
+void BlockedEventBatcher::Flush() {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  std::map<int, std::vector<BlockedEvent>> pending_events;
+  pending_events.swap(pending_events_);
+  for (auto& tab_events : pending_events) {
+    BrowserThread::PostTask(BrowserThread::UI, FROM_HERE,
+        base::BindOnce(&BraveShieldsWebContentsObserver::DispatchBlockedEvents,
+            std::move(tab_events.second)));
+  }
+}
+
+void BlockedEventBatcher::FlushTab(int tab_frame_tree_node_id) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  auto it = pending_events_.find(tab_frame_tree_node_id);
+  if (it == pending_events_.end()) {
+    return;
+  }
+  std::vector<BlockedEvent> events;
+  events.swap(it->second);
+  pending_events_.erase(it);
+  if (pending_events_.empty()) {
+    flush_timer_.Stop();
+  }
+  BrowserThread::PostTask(BrowserThread::UI, FROM_HERE,
+      base::BindOnce(&BraveShieldsWebContentsObserver::DispatchBlockedEvents,
+          std::move(events)));
+}
+
+}  // namespace brave_shields
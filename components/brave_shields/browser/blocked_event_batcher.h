@@ -0,0 +1,64 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_BLOCKED_EVENT_BATCHER_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_BLOCKED_EVENT_BATCHER_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/timer/timer.h"
+
+namespace brave_shields {
+
+// A request blocked by shields, the frame it was made from and the page its
+// tab was showing at the time.
+struct BlockedEvent {
+  BlockedEvent();
+  BlockedEvent(const BlockedEvent& other);
+  ~BlockedEvent();
+
+  std::string block_type;
+  std::string subresource;
+  int render_process_id;
+  int render_frame_id;
+  int frame_tree_node_id;
+  // See RenderFrameTabInfo. -1 and 0 if the tab is not known.
+  int tab_frame_tree_node_id;
+  int64_t navigation_id;
+  // The site the request was blocked on, for the per site counts.
+  std::string site;
+};
+
+// Collects the requests blocked on the IO thread and hands them to the UI
+// thread in batches, one per tab. A page full of ads then costs one UI task
+// and one round of pref updates every flush interval instead of one per
+// request. Must only be used on the IO thread.
+class BlockedEventBatcher {
+ public:
+  BlockedEventBatcher();
+  ~BlockedEventBatcher();
+
+  static BlockedEventBatcher* GetInstance();
+
+  void Add(const BlockedEvent& event);
+
+ private:
+  void Flush();
+  void FlushTab(int tab_frame_tree_node_id);
+
+  // Keyed by BlockedEvent::tab_frame_tree_node_id.
+  std::map<int, std::vector<BlockedEvent>> pending_events_;
+  base::OneShotTimer flush_timer_;
+
+  DISALLOW_COPY_AND_ASSIGN(BlockedEventBatcher);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_BLOCKED_EVENT_BATCHER_H_
@@ -9,6 +9,7 @@
 #include "brave/components/brave_shields/browser/ad_block_regional_service.h"
 #include "brave/components/brave_shields/browser/brave_shields_resource_throttle.h"
 #include "brave/components/brave_shields/browser/https_everywhere_service.h"
+#include "brave/components/brave_shields/browser/site_hacks_service.h"
 #include "brave/components/brave_shields/browser/tracking_protection_service.h"
 
 using content::ResourceType;
@@ -20,6 +21,7 @@ BraveResourceDispatcherHostDelegate::BraveResourceDispatcherHostDelegate() {
     g_brave_browser_process->ad_block_regional_service()->Start();
   g_brave_browser_process->https_everywhere_service()->Start();
   g_brave_browser_process->tracking_protection_service()->Start();
+  g_brave_browser_process->site_hacks_service()->Start();
 }
 
 BraveResourceDispatcherHostDelegate::~BraveResourceDispatcherHostDelegate() {
@@ -6,8 +6,8 @@
 
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
-#include "brave/components/brave_shields/browser/ad_block_regional_service.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "brave/components/brave_shields/browser/shields_latency_tracker.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "brave/components/brave_shields/browser/tracking_protection_service.h"
 #include "chrome/browser/profiles/profile_io_data.h"
@@ -16,6 +16,40 @@
 #include "net/url_request/url_request.h"
 
 
+namespace brave_shields {
+
+ShieldsBlockDecision GetShieldsBlockDecision(
+    const ShieldsPolicy& policy,
+    TrackingProtectionService* tracking_protection_service,
+    AdBlockService* ad_block_service,
+    const GURL& url,
+    content::ResourceType resource_type,
+    const std::string& tab_host,
+    bool is_off_the_record) {
+  ShieldsBlockDecision decision;
+  if (!policy.allow_brave_shields) {
+    return decision;
+  }
+  if (!policy.allow_trackers) {
+    ScopedShieldsLatencyTimer timer(
+        ShieldsLatencyStage::kTrackingProtectionMatch, url,
+        is_off_the_record);
+    decision.block_trackers =
+        !tracking_protection_service->ShouldStartRequest(url, resource_type,
+                                                         tab_host);
+  }
+  if (!policy.allow_ads) {
+    ScopedShieldsLatencyTimer timer(ShieldsLatencyStage::kAdBlockMatch, url,
+                                    is_off_the_record);
+    decision.block_ads =
+        !ad_block_service->ShouldStartRequestForAllLists(url, resource_type,
+                                                         tab_host, nullptr);
+  }
+  return decision;
+}
+
+}  // namespace brave_shields
+
 content::ResourceThrottle* MaybeCreateBraveShieldsResourceThrottle(
     net::URLRequest* request,
     content::ResourceType resource_type) {
@@ -42,28 +76,20 @@ void BraveShieldsResourceThrottle::WillStartRequest(bool* defer) {
   if (tab_origin.is_empty()) {
     return;
   }
-  bool allow_brave_shields = brave_shields::IsAllowContentSettingFromIO(
-      request_, tab_origin, tab_origin, CONTENT_SETTINGS_TYPE_PLUGINS,
-      brave_shields::kBraveShields);
-  bool allow_ads = brave_shields::IsAllowContentSettingFromIO(
-      request_, tab_origin, tab_origin, CONTENT_SETTINGS_TYPE_PLUGINS, brave_shields::kAds);
-  bool allow_trackers = brave_shields::IsAllowContentSettingFromIO(
-      request_, tab_origin, tab_origin,
-      CONTENT_SETTINGS_TYPE_PLUGINS, brave_shields::kTrackers);
-  if (allow_brave_shields &&
-      !allow_trackers &&
-      !g_brave_browser_process->tracking_protection_service()->
-      ShouldStartRequest(request_->url(), resource_type_, tab_origin.host())) {
+  brave_shields::ShieldsPolicy policy =
+      brave_shields::GetShieldsPolicyFromIO(request_, tab_origin);
+  brave_shields::ShieldsBlockDecision decision =
+      brave_shields::GetShieldsBlockDecision(policy,
+          g_brave_browser_process->tracking_protection_service(),
+          g_brave_browser_process->ad_block_service(),
+          request_->url(), resource_type_, tab_origin.host(),
+          brave_shields::IsOffTheRecordFromIO(request_));
+  if (decision.block_trackers) {
     Cancel();
     brave_shields::DispatchBlockedEventFromIO(request_,
         brave_shields::kTrackers);
   }
-  if (allow_brave_shields && !allow_ads &&
-      (!g_brave_browser_process->ad_block_service()->ShouldStartRequest(
-           request_->url(), resource_type_, tab_origin.host()) ||
-       !g_brave_browser_process->ad_block_regional_service()
-            ->ShouldStartRequest(request_->url(), resource_type_,
-                                 tab_origin.host()))) {
+  if (decision.block_ads) {
     Cancel();
     brave_shields::DispatchBlockedEventFromIO(request_,
         brave_shields::kAds);
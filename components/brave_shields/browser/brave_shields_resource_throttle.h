@@ -5,16 +5,45 @@
 #ifndef BRAVE_BROWSER_LOADER_BRAVE_SHIELDS_RESOURCE_THROTTLE_H_
 #define BRAVE_BROWSER_LOADER_BRAVE_SHIELDS_RESOURCE_THROTTLE_H_
 
+#include <string>
+
 #include "base/macros.h"
 #include "content/public/browser/resource_throttle.h"
 #include "content/public/common/resource_type.h"
 
+class GURL;
 
 namespace net {
 struct RedirectInfo;
 class URLRequest;
 }
 
+namespace brave_shields {
+
+class AdBlockService;
+class TrackingProtectionService;
+struct ShieldsPolicy;
+
+struct ShieldsBlockDecision {
+  bool block_trackers = false;
+  bool block_ads = false;
+};
+
+// The matching done by BraveShieldsResourceThrottle, kept apart from the
+// request so that the matching benchmark runs the same logic. Each match is
+// timed for the ShieldsLatencyTracker, which never keeps |url| if
+// |is_off_the_record|.
+ShieldsBlockDecision GetShieldsBlockDecision(
+    const ShieldsPolicy& policy,
+    TrackingProtectionService* tracking_protection_service,
+    AdBlockService* ad_block_service,
+    const GURL& url,
+    content::ResourceType resource_type,
+    const std::string& tab_host,
+    bool is_off_the_record);
+
+}  // namespace brave_shields
+
 // Contructs a resource throttle for Brave shields like tracking protection
 // and adblock. It returns a
 content::ResourceThrottle* MaybeCreateBraveShieldsResourceThrottle(
@@ -0,0 +1,158 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/brave_shields_stats_service.h"
+
+#include "base/bind.h"
+#include "base/logging.h"
+#include "brave/common/pref_names.h"
+#include "brave/components/brave_shields/common/brave_shield_constants.h"
+#include "components/prefs/pref_service.h"
+
+namespace {
+
+const int kPersistDelaySeconds = 30;
+// Keeps the new tab page to four updates a second.
+const int kNotifyDelayMs = 250;
+const size_t kMaxTabs = 100;
+const size_t kMaxSites = 100;
+
+const char* const kBlockedStatPrefNames[] = {
+  kAdsBlocked,
+  kTrackersBlocked,
+  kHttpsUpgrades,
+  kJavascriptBlocked,
+  kFingerprintingBlocked,
+};
+
+static_assert(arraysize(kBlockedStatPrefNames) ==
+                  brave_shields::kBlockedStatCount,
+              "Every blocked stat needs a pref");
+
+}  // namespace
+
+namespace brave_shields {
+
+BraveShieldsStatsService::BraveShieldsStatsService(PrefService* prefs)
+    : prefs_(prefs),
+      tab_counts_(kMaxTabs),
+      site_counts_(kMaxSites) {
+  for (size_t i = 0; i < kBlockedStatCount; i++) {
+    totals_[i] = prefs_->GetUint64(kBlockedStatPrefNames[i]);
+  }
+}
+
+BraveShieldsStatsService::~BraveShieldsStatsService() {
+}
+
+// static
+bool BraveShieldsStatsService::GetBlockedStatForBlockType(
+    const std::string& block_type, BlockedStat* stat) {
+  if (block_type == kAds) {
+    *stat = BlockedStat::kAds;
+  } else if (block_type == kTrackers) {
+    *stat = BlockedStat::kTrackers;
+  } else if (block_type == kHTTPUpgradableResources) {
+    *stat = BlockedStat::kHttpsUpgrades;
+  } else if (block_type == kJavaScript) {
+    *stat = BlockedStat::kJavascript;
+  } else if (block_type == kFingerprinting) {
+    *stat = BlockedStat::kFingerprinting;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+void BraveShieldsStatsService::Record(BlockedStat stat, int tab_id,
+    const std::string& site, uint64_t count) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  const size_t index = static_cast<size_t>(stat);
+  totals_[index] += count;
+
+  if (tab_id != -1) {
+    auto it = tab_counts_.Get(tab_id);
+    if (it == tab_counts_.end()) {
+      it = tab_counts_.Put(tab_id, BlockedStatCounts());
+    }
+    it->second[index] += count;
+  }
+  if (!site.empty()) {
+    auto it = site_counts_.Get(site);
+    if (it == site_counts_.end()) {
+      it = site_counts_.Put(site, BlockedStatCounts());
+    }
+    it->second[index] += count;
+  }
+
+  if (!persist_timer_.IsRunning()) {
+    persist_timer_.Start(FROM_HERE,
+        base::TimeDelta::FromSeconds(kPersistDelaySeconds),
+        base::Bind(&BraveShieldsStatsService::Persist,
+                   base::Unretained(this)));
+  }
+  if (!notify_timer_.IsRunning()) {
+    notify_timer_.Start(FROM_HERE,
+        base::TimeDelta::FromMilliseconds(kNotifyDelayMs),
+        base::Bind(&BraveShieldsStatsService::NotifyObservers,
+                   base::Unretained(this)));
+  }
+}
+
+void BraveShieldsStatsService::ClearTab(int tab_id) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  auto it = tab_counts_.Peek(tab_id);
+  if (it != tab_counts_.end()) {
+    tab_counts_.Erase(it);
+  }
+}
+
+uint64_t BraveShieldsStatsService::GetTotal(BlockedStat stat) const {
+  return totals_[static_cast<size_t>(stat)];
+}
+
+BlockedStatCounts BraveShieldsStatsService::GetTabCounts(int tab_id) const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  auto it = tab_counts_.Peek(tab_id);
+  return it == tab_counts_.end() ? BlockedStatCounts() : it->second;
+}
+
+BlockedStatCounts BraveShieldsStatsService::GetSiteCounts(
+    const std::string& site) const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  auto it = site_counts_.Peek(site);
+  return it == site_counts_.end() ? BlockedStatCounts() : it->second;
+}
+
+void BraveShieldsStatsService::AddObserver(Observer* observer) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  observers_.AddObserver(observer);
+}
+
+void BraveShieldsStatsService::RemoveObserver(Observer* observer) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  observers_.RemoveObserver(observer);
+}
+
+void BraveShieldsStatsService::Persist() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  persist_timer_.Stop();
+  for (size_t i = 0; i < kBlockedStatCount; i++) {
+    prefs_->SetUint64(kBlockedStatPrefNames[i], totals_[i]);
+  }
+}
+
+void BraveShieldsStatsService::Shutdown() {
+  notify_timer_.Stop();
+  Persist();
+}
+
+void BraveShieldsStatsService::NotifyObservers() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  for (Observer& observer : observers_) {
+    observer.OnShieldsStatsChanged();
+  }
+}
+
+}  // namespace brave_shields
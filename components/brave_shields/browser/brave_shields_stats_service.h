@@ -0,0 +1,103 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_BRAVE_SHIELDS_STATS_SERVICE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_BRAVE_SHIELDS_STATS_SERVICE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <atomic>
+#include <string>
+
+#include "base/containers/mru_cache.h"
+#include "base/macros.h"
+#include "base/observer_list.h"
+#include "base/sequence_checker.h"
+#include "base/timer/timer.h"
+#include "components/keyed_service/core/keyed_service.h"
+
+class PrefService;
+
+namespace brave_shields {
+
+enum class BlockedStat {
+  kAds = 0,
+  kTrackers,
+  kHttpsUpgrades,
+  kJavascript,
+  kFingerprinting,
+};
+
+const size_t kBlockedStatCount = 5;
+
+// Blocked counts indexed by BlockedStat.
+using BlockedStatCounts = std::array<uint64_t, kBlockedStatCount>;
+
+// Keeps the shields blocked counters of a profile in memory.
+//
+// The totals are seeded from and written back to the profile prefs, but only
+// every few seconds and at shutdown rather than on each block. Counts are
+// also broken down per tab and per site for the current session. Observers
+// are told about changes at most a few times per second.
+class BraveShieldsStatsService : public KeyedService {
+ public:
+  class Observer {
+   public:
+    virtual void OnShieldsStatsChanged() = 0;
+
+   protected:
+    virtual ~Observer() {}
+  };
+
+  explicit BraveShieldsStatsService(PrefService* prefs);
+  ~BraveShieldsStatsService() override;
+
+  // Maps a brave_shields block type such as kAds to its stat. Returns false
+  // for block types which are not counted.
+  static bool GetBlockedStatForBlockType(const std::string& block_type,
+                                         BlockedStat* stat);
+
+  // Adds |count| blocks of |stat| for |tab_id| and |site|. |tab_id| may be
+  // -1 and |site| empty if the block is not to be broken down.
+  void Record(BlockedStat stat, int tab_id, const std::string& site,
+              uint64_t count = 1);
+  // Forgets the per tab counts of |tab_id|.
+  void ClearTab(int tab_id);
+
+  // Unlike the other methods, may be called from any thread.
+  uint64_t GetTotal(BlockedStat stat) const;
+
+  BlockedStatCounts GetTabCounts(int tab_id) const;
+  BlockedStatCounts GetSiteCounts(const std::string& site) const;
+
+  void AddObserver(Observer* observer);
+  void RemoveObserver(Observer* observer);
+
+  // Writes the totals to prefs now instead of waiting for the timer.
+  void Persist();
+
+  // KeyedService:
+  void Shutdown() override;
+
+ private:
+  void NotifyObservers();
+
+  PrefService* prefs_;
+  std::atomic<uint64_t> totals_[kBlockedStatCount];
+  base::MRUCache<int, BlockedStatCounts> tab_counts_;
+  base::MRUCache<std::string, BlockedStatCounts> site_counts_;
+  base::OneShotTimer persist_timer_;
+  base::OneShotTimer notify_timer_;
+  base::ObserverList<Observer> observers_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+
+  DISALLOW_COPY_AND_ASSIGN(BraveShieldsStatsService);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_BRAVE_SHIELDS_STATS_SERVICE_H_
@@ -0,0 +1,48 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/brave_shields_stats_service_factory.h"
+
+#include "brave/components/brave_shields/browser/brave_shields_stats_service.h"
+#include "chrome/browser/profiles/incognito_helpers.h"
+#include "chrome/browser/profiles/profile.h"
+#include "components/keyed_service/content/browser_context_dependency_manager.h"
+
+namespace brave_shields {
+
+// static
+BraveShieldsStatsService* BraveShieldsStatsServiceFactory::GetForProfile(
+    Profile* profile) {
+  return static_cast<BraveShieldsStatsService*>(
+      GetInstance()->GetServiceForBrowserContext(profile, true));
+}
+
+// static
+BraveShieldsStatsServiceFactory*
+BraveShieldsStatsServiceFactory::GetInstance() {
+  return base::Singleton<BraveShieldsStatsServiceFactory>::get();
+}
+
+BraveShieldsStatsServiceFactory::BraveShieldsStatsServiceFactory()
+    : BrowserContextKeyedServiceFactory(
+          "BraveShieldsStatsService",
+          BrowserContextDependencyManager::GetInstance()) {
+}
+
+BraveShieldsStatsServiceFactory::~BraveShieldsStatsServiceFactory() {
+}
+
+KeyedService* BraveShieldsStatsServiceFactory::BuildServiceInstanceFor(
+    content::BrowserContext* context) const {
+  return new BraveShieldsStatsService(
+      Profile::FromBrowserContext(context)->GetPrefs());
+}
+
+content::BrowserContext*
+BraveShieldsStatsServiceFactory::GetBrowserContextToUse(
+    content::BrowserContext* context) const {
+  return chrome::GetBrowserContextRedirectedInIncognito(context);
+}
+
+}  // namespace brave_shields
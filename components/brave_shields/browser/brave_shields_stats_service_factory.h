@@ -0,0 +1,43 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_BRAVE_SHIELDS_STATS_SERVICE_FACTORY_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_BRAVE_SHIELDS_STATS_SERVICE_FACTORY_H_
+
+#include "base/memory/singleton.h"
+#include "components/keyed_service/content/browser_context_keyed_service_factory.h"
+
+class Profile;
+
+namespace brave_shields {
+
+class BraveShieldsStatsService;
+
+// Singleton that owns all BraveShieldsStatsService and associates them with
+// Profiles. Incognito profiles share the service of their original profile.
+class BraveShieldsStatsServiceFactory
+    : public BrowserContextKeyedServiceFactory {
+ public:
+  static BraveShieldsStatsService* GetForProfile(Profile* profile);
+
+  static BraveShieldsStatsServiceFactory* GetInstance();
+
+ private:
+  friend struct base::DefaultSingletonTraits<BraveShieldsStatsServiceFactory>;
+
+  BraveShieldsStatsServiceFactory();
+  ~BraveShieldsStatsServiceFactory() override;
+
+  // BrowserContextKeyedServiceFactory:
+  KeyedService* BuildServiceInstanceFor(
+      content::BrowserContext* context) const override;
+  content::BrowserContext* GetBrowserContextToUse(
+      content::BrowserContext* context) const override;
+
+  DISALLOW_COPY_AND_ASSIGN(BraveShieldsStatsServiceFactory);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_BRAVE_SHIELDS_STATS_SERVICE_FACTORY_H_
@@ -0,0 +1,110 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/brave_shields_stats_service.h"
+
+#include "base/test/scoped_task_environment.h"
+#include "base/time/time.h"
+#include "brave/common/pref_names.h"
+#include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
+#include "components/prefs/testing_pref_service.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using brave_shields::BlockedStat;
+using brave_shields::BlockedStatCounts;
+using brave_shields::BraveShieldsStatsService;
+
+namespace {
+
+class TestObserver : public BraveShieldsStatsService::Observer {
+ public:
+  TestObserver() : notifications_(0) {}
+  ~TestObserver() override {}
+
+  void OnShieldsStatsChanged() override { notifications_++; }
+
+  int notifications() const { return notifications_; }
+
+ private:
+  int notifications_;
+};
+
+class BraveShieldsStatsServiceTest : public testing::Test {
+ public:
+  BraveShieldsStatsServiceTest()
+      : scoped_task_environment_(
+            base::test::ScopedTaskEnvironment::MainThreadType::MOCK_TIME) {}
+  ~BraveShieldsStatsServiceTest() override {}
+
+  void SetUp() override {
+    brave_shields::BraveShieldsWebContentsObserver::RegisterProfilePrefs(
+        prefs_.registry());
+  }
+
+ protected:
+  base::test::ScopedTaskEnvironment scoped_task_environment_;
+  TestingPrefServiceSimple prefs_;
+};
+
+TEST_F(BraveShieldsStatsServiceTest, SeedsTotalsFromPrefs) {
+  prefs_.SetUint64(kAdsBlocked, 10);
+  prefs_.SetUint64(kFingerprintingBlocked, 3);
+  BraveShieldsStatsService service(&prefs_);
+  EXPECT_EQ(10u, service.GetTotal(BlockedStat::kAds));
+  EXPECT_EQ(0u, service.GetTotal(BlockedStat::kTrackers));
+  EXPECT_EQ(3u, service.GetTotal(BlockedStat::kFingerprinting));
+}
+
+TEST_F(BraveShieldsStatsServiceTest, BreaksDownByTabAndSite) {
+  BraveShieldsStatsService service(&prefs_);
+  service.Record(BlockedStat::kAds, 1, "brave.com");
+  service.Record(BlockedStat::kAds, 1, "brave.com");
+  service.Record(BlockedStat::kTrackers, 2, "brave.com");
+  service.Record(BlockedStat::kHttpsUpgrades, -1, std::string(), 5);
+
+  EXPECT_EQ(2u, service.GetTotal(BlockedStat::kAds));
+  EXPECT_EQ(5u, service.GetTotal(BlockedStat::kHttpsUpgrades));
+
+  BlockedStatCounts tab_counts = service.GetTabCounts(1);
+  EXPECT_EQ(2u, tab_counts[static_cast<size_t>(BlockedStat::kAds)]);
+  EXPECT_EQ(0u, tab_counts[static_cast<size_t>(BlockedStat::kTrackers)]);
+
+  BlockedStatCounts site_counts = service.GetSiteCounts("brave.com");
+  EXPECT_EQ(2u, site_counts[static_cast<size_t>(BlockedStat::kAds)]);
+  EXPECT_EQ(1u, site_counts[static_cast<size_t>(BlockedStat::kTrackers)]);
+
+  service.ClearTab(1);
+  tab_counts = service.GetTabCounts(1);
+  EXPECT_EQ(0u, tab_counts[static_cast<size_t>(BlockedStat::kAds)]);
+}
+
+TEST_F(BraveShieldsStatsServiceTest, PersistsAfterDelay) {
+  BraveShieldsStatsService service(&prefs_);
+  service.Record(BlockedStat::kAds, 1, "brave.com");
+  EXPECT_EQ(0u, prefs_.GetUint64(kAdsBlocked));
+
+  scoped_task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(1));
+  EXPECT_EQ(1u, prefs_.GetUint64(kAdsBlocked));
+
+  service.Record(BlockedStat::kAds, 1, "brave.com");
+  service.Shutdown();
+  EXPECT_EQ(2u, prefs_.GetUint64(kAdsBlocked));
+}
+
+TEST_F(BraveShieldsStatsServiceTest, ThrottlesNotifications) {
+  BraveShieldsStatsService service(&prefs_);
+  TestObserver observer;
+  service.AddObserver(&observer);
+
+  for (int i = 0; i < 100; i++) {
+    service.Record(BlockedStat::kTrackers, 1, "brave.com");
+  }
+  EXPECT_EQ(0, observer.notifications());
+  scoped_task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(1));
+  EXPECT_EQ(1, observer.notifications());
+
+  service.RemoveObserver(&observer);
+}
+
+}  // namespace
@@ -4,14 +4,22 @@
 
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
 
-#include "brave/common/shield_exceptions.h"
+#include "base/containers/mru_cache.h"
+#include "base/memory/ptr_util.h"
+#include "base/supports_user_data.h"
+#include "brave/components/brave_shields/browser/blocked_event_batcher.h"
 #include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
+#include "brave/components/brave_shields/browser/render_frame_tab_url_map.h"
+#include "brave/components/brave_shields/browser/shield_exceptions.h"
+#include "brave/components/brave_shields/common/brave_shield_constants.h"
+#include "brave/components/content_settings/core/browser/brave_host_content_settings_map.h"
 #include "chrome/browser/extensions/extension_tab_util.h"
 #include "chrome/browser/profiles/profile_io_data.h"
 #include "components/content_settings/core/browser/host_content_settings_map.h"
 #include "components/content_settings/core/common/content_settings_types.h"
 #include "components/content_settings/core/common/content_settings_utils.h"
 #include "content/public/common/referrer.h"
+#include "content/public/browser/resource_context.h"
 #include "content/public/browser/resource_request_info.h"
 #include "content/public/browser/websocket_handshake_request_info.h"
 #include "extensions/browser/extension_api_frame_id_map.h"
@@ -40,25 +48,18 @@ bool GetDefaultFromResourceIdentifier(const std::string& resource_identifier) {
   return false;
 }
 
-bool IsAllowContentSettingFromIO(net::URLRequest* request,
+namespace {
+
+const char kShieldsPolicyCacheKey[] = "brave_shields_policy_cache";
+const size_t kShieldsPolicyCacheSize = 100;
+
+bool IsAllowContentSetting(HostContentSettingsMap* map,
     const GURL& primary_url, const GURL& secondary_url,
     ContentSettingsType setting_type,
     const std::string& resource_identifier) {
-  DCHECK_CURRENTLY_ON(BrowserThread::IO);
-
-  const content::ResourceRequestInfo* resource_info =
-      content::ResourceRequestInfo::ForRequest(request);
-  if (!resource_info) {
-    return GetDefaultFromResourceIdentifier(resource_identifier);
-  }
-  ProfileIOData* io_data =
-      ProfileIOData::FromResourceContext(resource_info->GetContext());
-  if (!io_data) {
-    return GetDefaultFromResourceIdentifier(resource_identifier);
-  }
   content_settings::SettingInfo setting_info;
   std::unique_ptr<base::Value> value =
-      io_data->GetHostContentSettingsMap()->GetWebsiteSetting(
+      map->GetWebsiteSetting(
           primary_url, secondary_url,
           setting_type,
           resource_identifier, &setting_info);
@@ -73,6 +74,137 @@ bool IsAllowContentSettingFromIO(net::URLRequest* request,
   return setting == CONTENT_SETTING_ALLOW;
 }
 
+ShieldsPolicy GetShieldsPolicy(HostContentSettingsMap* map,
+                               const GURL& tab_origin) {
+  ShieldsPolicy policy;
+  policy.allow_brave_shields = IsAllowContentSetting(map, tab_origin,
+      tab_origin, CONTENT_SETTINGS_TYPE_PLUGINS, kBraveShields);
+  policy.allow_ads = IsAllowContentSetting(map, tab_origin, tab_origin,
+      CONTENT_SETTINGS_TYPE_PLUGINS, kAds);
+  policy.allow_trackers = IsAllowContentSetting(map, tab_origin, tab_origin,
+      CONTENT_SETTINGS_TYPE_PLUGINS, kTrackers);
+  policy.allow_http_upgradable_resources = IsAllowContentSetting(map,
+      tab_origin, tab_origin, CONTENT_SETTINGS_TYPE_PLUGINS,
+      kHTTPUpgradableResources);
+  policy.allow_referrers = IsAllowContentSetting(map, tab_origin, tab_origin,
+      CONTENT_SETTINGS_TYPE_PLUGINS, kReferrers);
+  return policy;
+}
+
+ShieldsPolicy GetDefaultShieldsPolicy() {
+  ShieldsPolicy policy;
+  policy.allow_brave_shields = GetDefaultFromResourceIdentifier(kBraveShields);
+  policy.allow_ads = GetDefaultFromResourceIdentifier(kAds);
+  policy.allow_trackers = GetDefaultFromResourceIdentifier(kTrackers);
+  policy.allow_http_upgradable_resources =
+      GetDefaultFromResourceIdentifier(kHTTPUpgradableResources);
+  policy.allow_referrers = GetDefaultFromResourceIdentifier(kReferrers);
+  return policy;
+}
+
+// Shields policies of the tab origins recently seen by a profile. Only used
+// on the IO thread, it lives on the profile's ResourceContext.
+class ShieldsPolicyCache : public base::SupportsUserData::Data {
+ public:
+  ShieldsPolicyCache()
+      : settings_version_(0),
+        policies_(kShieldsPolicyCacheSize) {}
+  ~ShieldsPolicyCache() override {}
+
+  static ShieldsPolicyCache* FromResourceContext(
+      content::ResourceContext* context) {
+    ShieldsPolicyCache* cache = static_cast<ShieldsPolicyCache*>(
+        context->GetUserData(kShieldsPolicyCacheKey));
+    if (!cache) {
+      cache = new ShieldsPolicyCache();
+      context->SetUserData(kShieldsPolicyCacheKey, base::WrapUnique(cache));
+    }
+    return cache;
+  }
+
+  ShieldsPolicy Get(BraveHostContentSettingsMap* map,
+                    const GURL& tab_origin) {
+    uint64_t settings_version = map->GetSettingsVersion();
+    if (settings_version != settings_version_) {
+      policies_.Clear();
+      settings_version_ = settings_version;
+    }
+    auto it = policies_.Get(tab_origin.spec());
+    if (it != policies_.end()) {
+      return it->second;
+    }
+    ShieldsPolicy policy = GetShieldsPolicy(map, tab_origin);
+    policies_.Put(tab_origin.spec(), policy);
+    return policy;
+  }
+
+ private:
+  uint64_t settings_version_;
+  base::MRUCache<std::string, ShieldsPolicy> policies_;
+
+  DISALLOW_COPY_AND_ASSIGN(ShieldsPolicyCache);
+};
+
+}  // namespace
+
+ShieldsPolicy GetShieldsPolicyFromIO(net::URLRequest* request,
+                                     const GURL& tab_origin) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+
+  const content::ResourceRequestInfo* resource_info =
+      content::ResourceRequestInfo::ForRequest(request);
+  if (!resource_info) {
+    return GetDefaultShieldsPolicy();
+  }
+  ProfileIOData* io_data =
+      ProfileIOData::FromResourceContext(resource_info->GetContext());
+  if (!io_data) {
+    return GetDefaultShieldsPolicy();
+  }
+  // Every profile's map is created by HostContentSettingsMapFactory, which
+  // makes a BraveHostContentSettingsMap.
+  BraveHostContentSettingsMap* map = static_cast<BraveHostContentSettingsMap*>(
+      io_data->GetHostContentSettingsMap());
+  return ShieldsPolicyCache::FromResourceContext(resource_info->GetContext())
+      ->Get(map, tab_origin);
+}
+
+bool IsOffTheRecordFromIO(net::URLRequest* request) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+
+  const content::ResourceRequestInfo* resource_info =
+      content::ResourceRequestInfo::ForRequest(request);
+  if (!resource_info) {
+    return true;
+  }
+  ProfileIOData* io_data =
+      ProfileIOData::FromResourceContext(resource_info->GetContext());
+  if (!io_data) {
+    return true;
+  }
+  return io_data->IsOffTheRecord();
+}
+
+bool IsAllowContentSettingFromIO(net::URLRequest* request,
+    const GURL& primary_url, const GURL& secondary_url,
+    ContentSettingsType setting_type,
+    const std::string& resource_identifier) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+
+  const content::ResourceRequestInfo* resource_info =
+      content::ResourceRequestInfo::ForRequest(request);
+  if (!resource_info) {
+    return GetDefaultFromResourceIdentifier(resource_identifier);
+  }
+  ProfileIOData* io_data =
+      ProfileIOData::FromResourceContext(resource_info->GetContext());
+  if (!io_data) {
+    return GetDefaultFromResourceIdentifier(resource_identifier);
+  }
+  return IsAllowContentSetting(io_data->GetHostContentSettingsMap(),
+      primary_url, secondary_url, setting_type, resource_identifier);
+}
+
 void GetRenderFrameInfo(URLRequest* request,
     int* render_frame_id,
     int* render_process_id,
@@ -102,13 +234,27 @@ void GetRenderFrameInfo(URLRequest* request,
 void DispatchBlockedEventFromIO(URLRequest* request,
     const std::string& block_type) {
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
-  int render_process_id, render_frame_id, frame_tree_node_id;
-  GetRenderFrameInfo(request, &render_frame_id, &render_process_id,
-      &frame_tree_node_id);
-  BrowserThread::PostTask(BrowserThread::UI, FROM_HERE,
-      base::BindOnce(&BraveShieldsWebContentsObserver::DispatchBlockedEvent,
-          block_type, request->url().spec(),
-          render_process_id, render_frame_id, frame_tree_node_id));
+  BlockedEvent event;
+  event.block_type = block_type;
+  event.subresource = request->url().spec();
+  GetRenderFrameInfo(request, &event.render_frame_id,
+      &event.render_process_id, &event.frame_tree_node_id);
+  RenderFrameTabInfo tab_info;
+  if (BraveShieldsWebContentsObserver::GetTabInfoFromRenderFrameInfo(
+          event.render_process_id, event.render_frame_id, &tab_info)) {
+    event.tab_frame_tree_node_id = tab_info.tab_frame_tree_node_id;
+    event.navigation_id = tab_info.navigation_id;
+  }
+  // Taken now rather than when the batch is dispatched, by which time the
+  // tab may show another site.
+  event.site = GetSiteForStats(tab_info.tab_url.is_empty() ?
+      request->site_for_cookies() : tab_info.tab_url);
+  BlockedEventBatcher::GetInstance()->Add(event);
+}
+
+std::string GetSiteForStats(const GURL& url) {
+  std::string site = GetDomainAndRegistry(url, INCLUDE_PRIVATE_REGISTRIES);
+  return site.empty() ? url.host() : site;
 }
 
 bool ShouldSetReferrer(bool allow_referrers, bool shields_up,
@@ -23,6 +23,27 @@ class GURL;
 
 namespace brave_shields {
 
+// The shields settings which apply to every request made from a tab, as seen
+// from the IO thread.
+struct ShieldsPolicy {
+  bool allow_brave_shields = true;
+  bool allow_ads = false;
+  bool allow_trackers = false;
+  bool allow_http_upgradable_resources = false;
+  bool allow_referrers = false;
+};
+
+// Returns the shields settings for requests made from |tab_origin|. They are
+// looked up once per profile and tab origin, and looked up again only after
+// a content setting changes.
+ShieldsPolicy GetShieldsPolicyFromIO(net::URLRequest* request,
+                                     const GURL& tab_origin);
+
+// Returns true if |request| was made by an off the record profile. Requests
+// whose profile is unknown count as off the record, so that callers which
+// keep request details never keep incognito ones.
+bool IsOffTheRecordFromIO(net::URLRequest* request);
+
 bool IsAllowContentSettingFromIO(net::URLRequest* request,
     const GURL& primary_url, const GURL& secondary_url,
     ContentSettingsType setting_type,
@@ -31,6 +52,10 @@ bool IsAllowContentSettingFromIO(net::URLRequest* request,
 void DispatchBlockedEventFromIO(net::URLRequest* request,
     const std::string& block_type);
 
+// Returns the site |url| is counted under in the per site stats: its
+// registrable domain, falling back to the host.
+std::string GetSiteForStats(const GURL& url);
+
 void GetRenderFrameInfo(net::URLRequest* request,
     int* render_frame_id,
     int* render_process_id,
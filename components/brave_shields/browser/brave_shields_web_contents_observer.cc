@@ -4,21 +4,26 @@
 
 #include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
 
+#include <utility>
+
+#include "base/lazy_instance.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/common/extensions/api/brave_shields.h"
 #include "brave/common/pref_names.h"
 #include "brave/common/render_messages.h"
+#include "brave/components/brave_shields/browser/blocked_event_batcher.h"
+#include "brave/components/brave_shields/browser/brave_shields_stats_service.h"
+#include "brave/components/brave_shields/browser/brave_shields_stats_service_factory.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "brave/components/brave_shields/browser/render_frame_tab_url_map.h"
+#include "brave/components/brave_shields/browser/renderer_content_setting_rules_cache.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "brave/content/common/frame_messages.h"
 #include "chrome/browser/content_settings/host_content_settings_map_factory.h"
 #include "chrome/browser/extensions/extension_tab_util.h"
 #include "chrome/browser/profiles/profile.h"
-#include "chrome/common/renderer_configuration.mojom.h"
 #include "components/content_settings/core/browser/host_content_settings_map.h"
-#include "components/content_settings/core/common/content_settings_utils.h"
 #include "components/prefs/pref_registry_simple.h"
-#include "components/prefs/pref_service.h"
 #include "content/browser/frame_host/frame_tree_node.h"
 #include "content/browser/frame_host/navigator.h"
 #include "content/public/browser/browser_thread.h"
@@ -32,36 +37,6 @@
 #include "extensions/browser/extension_api_frame_id_map.h"
 #include "ipc/ipc_message_macros.h"
 
-namespace {
-
-// Content Settings are only sent to the main frame currently.
-// Chrome may fix this at some point, but for now we do this as a work-around.
-// You can verify if this is fixed by running the following test:
-// npm run test -- brave_browser_tests --filter=BraveContentSettingsObserverBrowserTest.*
-// Chrome seems to also have a bug with RenderFrameHostChanged not updating the content settings
-// so this is fixed here too. That case is coveredd in tests by:
-// npm run test -- brave_browser_tests --filter=BraveContentSettingsObserverBrowserTest.*
-void UpdateContentSettingsToRendererFrames(content::WebContents* web_contents) {
-  for (content::RenderFrameHost* frame : web_contents->GetAllFrames()) {
-    Profile* profile =
-        Profile::FromBrowserContext(web_contents->GetBrowserContext());
-    const HostContentSettingsMap* map =
-        HostContentSettingsMapFactory::GetForProfile(profile);
-    RendererContentSettingRules rules;
-    GetRendererContentSettingRules(map, &rules);
-    IPC::ChannelProxy* channel =
-        frame->GetProcess()->GetChannel();
-    // channel might be NULL in tests.
-    if (channel) {
-      chrome::mojom::RendererConfigurationAssociatedPtr rc_interface;
-      channel->GetRemoteAssociatedInterface(&rc_interface);
-      rc_interface->SetContentSettingRules(rules);
-    }
-  }
-}
-
-}  // namespace
-
 using extensions::Event;
 using extensions::EventRouter;
 using content::Referrer;
@@ -73,6 +48,10 @@ DEFINE_WEB_CONTENTS_USER_DATA_KEY(
 
 namespace {
 
+// Written on the UI thread, read on the IO thread.
+base::LazyInstance<brave_shields::RenderFrameTabURLMap>::Leaky g_tab_urls =
+    LAZY_INSTANCE_INITIALIZER;
+
 WebContents* GetWebContents(
     int render_process_id,
     int render_frame_id,
@@ -95,66 +74,42 @@ WebContents* GetWebContents(
 
 namespace brave_shields {
 
-base::Lock BraveShieldsWebContentsObserver::frame_data_map_lock_;
-std::map<BraveShieldsWebContentsObserver::RenderFrameIdKey, GURL>
-    BraveShieldsWebContentsObserver::render_frame_key_to_tab_url;
-
-BraveShieldsWebContentsObserver::RenderFrameIdKey::RenderFrameIdKey()
-    : render_process_id(content::ChildProcessHost::kInvalidUniqueID),
-      frame_routing_id(MSG_ROUTING_NONE) {}
-
-BraveShieldsWebContentsObserver::RenderFrameIdKey::RenderFrameIdKey(
-    int render_process_id,
-    int frame_routing_id)
-    : render_process_id(render_process_id),
-      frame_routing_id(frame_routing_id) {}
-
-bool BraveShieldsWebContentsObserver::RenderFrameIdKey::operator<(
-    const RenderFrameIdKey& other) const {
-  return std::tie(render_process_id, frame_routing_id) <
-         std::tie(other.render_process_id, other.frame_routing_id);
-}
-
-bool BraveShieldsWebContentsObserver::RenderFrameIdKey::operator==(
-    const RenderFrameIdKey& other) const {
-  return render_process_id == other.render_process_id &&
-         frame_routing_id == other.frame_routing_id;
-}
-
 BraveShieldsWebContentsObserver::~BraveShieldsWebContentsObserver() {
 }
 
 BraveShieldsWebContentsObserver::BraveShieldsWebContentsObserver(
     WebContents* web_contents)
-    : WebContentsObserver(web_contents) {
+    : WebContentsObserver(web_contents),
+      navigation_id_(0) {
 }
 
 void BraveShieldsWebContentsObserver::RenderFrameCreated(
     RenderFrameHost* rfh) {
   WebContents* web_contents = WebContents::FromRenderFrameHost(rfh);
   if (web_contents) {
-    UpdateContentSettingsToRendererFrames(web_contents);
-    base::AutoLock lock(frame_data_map_lock_);
-    const RenderFrameIdKey key(rfh->GetProcess()->GetID(), rfh->GetRoutingID());
-    std::map<RenderFrameIdKey, GURL>::iterator iter =
-        render_frame_key_to_tab_url.find(key);
-    if (iter != render_frame_key_to_tab_url.end()) {
-      render_frame_key_to_tab_url.erase(key);
-    }
-    render_frame_key_to_tab_url.insert(
-        std::pair<RenderFrameIdKey, GURL>(key, web_contents->GetURL()));
+    // Content Settings are only sent to the main frame currently.
+    // Chrome may fix this at some point, but for now we do this as a
+    // work-around. You can verify if this is fixed by running the following
+    // test:
+    // npm run test -- brave_browser_tests --filter=BraveContentSettingsObserverBrowserTest.*
+    // Chrome seems to also have a bug with RenderFrameHostChanged not
+    // updating the content settings so this is fixed here too. That case is
+    // covered in tests by the same filter.
+    RendererContentSettingRulesCache::GetInstance()->UpdateRenderProcesses(
+        web_contents);
+    RenderFrameTabInfo tab_info;
+    tab_info.tab_frame_tree_node_id =
+        web_contents->GetMainFrame()->GetFrameTreeNodeId();
+    tab_info.navigation_id = navigation_id_;
+    tab_info.tab_url = web_contents->GetURL();
+    g_tab_urls.Get().Set(rfh->GetProcess()->GetID(), rfh->GetRoutingID(),
+                         std::move(tab_info));
   }
 }
 
 void BraveShieldsWebContentsObserver::RenderFrameDeleted(
     RenderFrameHost* rfh) {
-  base::AutoLock lock(frame_data_map_lock_);
-  const RenderFrameIdKey key(rfh->GetProcess()->GetID(), rfh->GetRoutingID());
-  std::map<RenderFrameIdKey, GURL>::iterator iter =
-      render_frame_key_to_tab_url.find(key);
-  if (iter != render_frame_key_to_tab_url.end()) {
-    render_frame_key_to_tab_url.erase(key);
-  }
+  g_tab_urls.Get().Remove(rfh->GetProcess()->GetID(), rfh->GetRoutingID());
 }
 
 void BraveShieldsWebContentsObserver::RenderFrameHostChanged(
@@ -170,48 +125,53 @@ void BraveShieldsWebContentsObserver::RenderFrameHostChanged(
 // static
 GURL BraveShieldsWebContentsObserver::GetTabURLFromRenderFrameInfo(
     int render_process_id, int render_frame_id) {
-  base::AutoLock lock(frame_data_map_lock_);
-  const RenderFrameIdKey key(render_process_id, render_frame_id);
-  std::map<RenderFrameIdKey, GURL>::iterator iter =
-      render_frame_key_to_tab_url.find(key);
-  if (iter != render_frame_key_to_tab_url.end()) {
-    return iter->second;
-  }
-  return GURL();
+  return g_tab_urls.Get().Get(render_process_id, render_frame_id);
 }
 
-void BraveShieldsWebContentsObserver::DispatchBlockedEvent(
-    const std::string& block_type,
-    const std::string& subresource,
-    int render_process_id,
-    int render_frame_id,
-    int frame_tree_node_id) {
-  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+// static
+bool BraveShieldsWebContentsObserver::GetTabInfoFromRenderFrameInfo(
+    int render_process_id, int render_frame_id, RenderFrameTabInfo* tab_info) {
+  return g_tab_urls.Get().GetTabInfo(render_process_id, render_frame_id,
+                                     tab_info);
+}
 
-  WebContents* web_contents = GetWebContents(render_process_id,
-    render_frame_id, frame_tree_node_id);
-  DispatchBlockedEventForWebContents(block_type, subresource, web_contents);
+void BraveShieldsWebContentsObserver::DispatchBlockedEvents(
+    std::vector<BlockedEvent> events) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
 
-  if (web_contents) {
-    PrefService* prefs = Profile::FromBrowserContext(
-        web_contents->GetBrowserContext())->
-        GetOriginalProfile()->
-        GetPrefs();
-
-    if (block_type == kAds) {
-      prefs->SetUint64(kAdsBlocked, prefs->GetUint64(kAdsBlocked) + 1);
-    } else if (block_type == kTrackers) {
-      prefs->SetUint64(kTrackersBlocked,
-          prefs->GetUint64(kTrackersBlocked) + 1);
-    } else if (block_type == kHTTPUpgradableResources) {
-      prefs->SetUint64(kHttpsUpgrades, prefs->GetUint64(kHttpsUpgrades) + 1);
-    } else if (block_type == kJavaScript) {
-      prefs->SetUint64(kJavascriptBlocked,
-          prefs->GetUint64(kJavascriptBlocked) + 1);
-    } else if (block_type == kFingerprinting) {
-      prefs->SetUint64(kFingerprintingBlocked,
-          prefs->GetUint64(kFingerprintingBlocked) + 1);
+  for (const BlockedEvent& event : events) {
+    WebContents* web_contents = GetWebContents(event.render_process_id,
+      event.render_frame_id, event.frame_tree_node_id);
+    BraveShieldsWebContentsObserver* observer = web_contents ?
+        BraveShieldsWebContentsObserver::FromWebContents(web_contents) :
+        nullptr;
+    // The events reach the UI thread after the tab may have moved on to
+    // another page, which must not show or count what the old one blocked.
+    // The old page's site is still credited.
+    const bool current_page = !observer || event.navigation_id == 0 ||
+        event.navigation_id == observer->navigation_id_;
+    if (current_page) {
+      DispatchBlockedEventForWebContents(event.block_type, event.subresource,
+          web_contents);
     }
+    BlockedStat stat;
+    if (!web_contents ||
+        !BraveShieldsStatsService::GetBlockedStatForBlockType(
+            event.block_type, &stat)) {
+      continue;
+    }
+    Profile* profile =
+        Profile::FromBrowserContext(web_contents->GetBrowserContext());
+    BraveShieldsStatsService* stats_service =
+        BraveShieldsStatsServiceFactory::GetForProfile(profile);
+    if (!stats_service) {
+      continue;
+    }
+    // Per site counts are kept for the session only, but incognito sites
+    // are still left out of them.
+    stats_service->Record(stat, current_page ?
+        extensions::ExtensionTabUtil::GetTabId(web_contents) : -1,
+        profile->IsOffTheRecord() ? std::string() : event.site);
   }
 }
 
@@ -289,6 +249,16 @@ void BraveShieldsWebContentsObserver::RegisterProfilePrefs(
   registry->RegisterStringPref(kAdBlockCurrentRegion, "");
 }
 
+void BraveShieldsWebContentsObserver::WebContentsDestroyed() {
+  BraveShieldsStatsService* stats_service =
+      BraveShieldsStatsServiceFactory::GetForProfile(
+          Profile::FromBrowserContext(web_contents()->GetBrowserContext()));
+  if (stats_service) {
+    stats_service->ClearTab(
+        extensions::ExtensionTabUtil::GetTabId(web_contents()));
+  }
+}
+
 void BraveShieldsWebContentsObserver::ReadyToCommitNavigation(
     content::NavigationHandle* navigation_handle) {
   auto frame_tree_node_id = navigation_handle->GetFrameTreeNodeId();
@@ -337,6 +307,20 @@ void BraveShieldsWebContentsObserver::ReadyToCommitNavigation(
     navigation_entry->SetReferrer(new_referrer);
   }
 
+  if (navigation_handle->IsInMainFrame() &&
+      !navigation_handle->IsSameDocument()) {
+    // Requests blocked from here on belong to the new page. Frames of the old
+    // one keep the old navigation until they are deleted.
+    navigation_id_ = navigation_handle->GetNavigationId();
+    RenderFrameHost* rfh = navigation_handle->GetRenderFrameHost();
+    RenderFrameTabInfo tab_info;
+    tab_info.tab_frame_tree_node_id = frame_tree_node_id;
+    tab_info.navigation_id = navigation_id_;
+    tab_info.tab_url = navigation_handle->GetURL();
+    g_tab_urls.Get().Set(rfh->GetProcess()->GetID(), rfh->GetRoutingID(),
+                         std::move(tab_info));
+  }
+
   // when the main frame navigate away
   if (navigation_handle->IsInMainFrame() &&
       !navigation_handle->IsSameDocument() &&
@@ -5,8 +5,9 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_H_
 #define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_H_
 
+#include <stdint.h>
+
 #include "base/macros.h"
-#include "base/synchronization/lock.h"
 #include "base/strings/string16.h"
 #include "content/public/browser/web_contents_observer.h"
 #include "content/public/browser/web_contents_user_data.h"
@@ -19,6 +20,9 @@ class PrefRegistrySimple;
 
 namespace brave_shields {
 
+struct BlockedEvent;
+struct RenderFrameTabInfo;
+
 class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
     public content::WebContentsUserData<BraveShieldsWebContentsObserver> {
  public:
@@ -30,31 +34,19 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
       const std::string& block_type,
       const std::string& subresource,
       content::WebContents* web_contents);
-  static void DispatchBlockedEvent(
-      const std::string& block_type,
-      const std::string& subresource,
-      int render_process_id,
-      int render_frame_id, int frame_tree_node_id);
+  // Dispatches a batch of requests blocked on the IO thread and records them
+  // with the BraveShieldsStatsService of their profile. Requests blocked on a
+  // page the tab has since navigated away from are not counted for the tab.
+  static void DispatchBlockedEvents(std::vector<BlockedEvent> events);
   static GURL GetTabURLFromRenderFrameInfo(int render_process_id, int render_frame_id);
+  // Returns false if the frame is not known.
+  static bool GetTabInfoFromRenderFrameInfo(int render_process_id,
+                                            int render_frame_id,
+                                            RenderFrameTabInfo* tab_info);
   void AllowScriptsOnce(const std::vector<std::string>& origins,
                         content::WebContents* web_contents);
 
  protected:
-    // A set of identifiers that uniquely identifies a RenderFrame.
-  struct RenderFrameIdKey {
-    RenderFrameIdKey();
-    RenderFrameIdKey(int render_process_id, int frame_routing_id);
-
-    // The process ID of the renderer that contains the RenderFrame.
-    int render_process_id;
-
-    // The routing ID of the RenderFrame.
-    int frame_routing_id;
-
-    bool operator<(const RenderFrameIdKey& other) const;
-    bool operator==(const RenderFrameIdKey& other) const;
-  };
-
   // content::WebContentsObserver overrides.
   void RenderFrameCreated(content::RenderFrameHost* host) override;
   void RenderFrameDeleted(content::RenderFrameHost* render_frame_host) override;
@@ -62,6 +54,7 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
                               content::RenderFrameHost* new_host) override;
   void ReadyToCommitNavigation(
       content::NavigationHandle* navigation_handle) override;
+  void WebContentsDestroyed() override;
 
   // Invoked if an IPC message is coming from a specific RenderFrameHost.
   bool OnMessageReceived(const IPC::Message& message,
@@ -73,14 +66,12 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
       content::RenderFrameHost* render_frame_host,
       const base::string16& details);
 
-  static std::map<RenderFrameIdKey, GURL> render_frame_key_to_tab_url;
-  // This lock protects |frame_data_map_| from being concurrently written on the
-  // UI thread and read on the IO thread.
-  static base::Lock frame_data_map_lock_;
-
   private:
     friend class content::WebContentsUserData<BraveShieldsWebContentsObserver>;
     std::vector<std::string> allowed_script_origins_;
+    // The main frame navigation the tab's frames are attributed to, or 0
+    // before the first one.
+    int64_t navigation_id_;
 
   DISALLOW_COPY_AND_ASSIGN(BraveShieldsWebContentsObserver);
 };
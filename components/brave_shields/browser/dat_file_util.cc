@@ -6,11 +6,14 @@
 
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/logging.h"
+#include "base/threading/thread_restrictions.h"
 
 namespace brave_shields {
 
-void GetDATFileData(const base::FilePath& file_path,
-                    DATFileDataBuffer* buffer) {
+std::unique_ptr<DATFileData> GetDATFileData(const base::FilePath& file_path) {
+  base::AssertBlockingAllowed();
   int64_t size = 0;
   if (!base::PathExists(file_path) ||
       !base::GetFileSize(file_path, &size) ||
@@ -18,14 +21,20 @@ void GetDATFileData(const base::FilePath& file_path,
     LOG(ERROR) << "GetDATFileData: "
                << "the dat file is not found or corrupted "
                << file_path;
-    return;
+    return nullptr;
   }
 
-  buffer->resize(size);
-  if (size != base::ReadFile(file_path, (char*)&buffer->front(), size)) {
+  std::unique_ptr<DATFileData> data(new base::MemoryMappedFile());
+  if (!data->Initialize(file_path, base::MemoryMappedFile::READ_WRITE_COPY)) {
     LOG(ERROR) << "GetDATFileData: cannot "
-               << "read dat file " << file_path;
+               << "map dat file " << file_path;
+    return nullptr;
   }
+  return data;
+}
+
+char* GetDATFileDataPointer(DATFileData* data) {
+  return reinterpret_cast<char*>(data->data());
 }
 
 }  // namespace brave_shields
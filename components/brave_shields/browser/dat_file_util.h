@@ -5,20 +5,29 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_DAT_FILE_UTIL_H_
 #define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_DAT_FILE_UTIL_H_
 
-#include <vector>
-
-#include "base/callback_forward.h"
+#include <memory>
 
 namespace base {
 class FilePath;
+class MemoryMappedFile;
 }
 
 namespace brave_shields {
 
-using DATFileDataBuffer = std::vector<unsigned char>;
+// The ad-block and tracking protection clients keep pointers into the data
+// they are deserialized from, so a DAT file is mapped rather than read and the
+// mapping must outlive the client. Its pages are then backed by the page cache
+// instead of private heap.
+using DATFileData = base::MemoryMappedFile;
+
+// Maps |file_path| copy-on-write, so the clients may scribble on the buffer
+// without touching the file on disk. Returns nullptr if the file is missing,
+// empty or cannot be mapped. Must be called where blocking is allowed.
+std::unique_ptr<DATFileData> GetDATFileData(const base::FilePath& file_path);
 
-void GetDATFileData(const base::FilePath& file_path,
-                    DATFileDataBuffer* buffer);
+// Returns the start of the mapped data, in the form the clients'
+// deserialize() expects.
+char* GetDATFileDataPointer(DATFileData* data);
 
 }  // namespace brave_shields
 
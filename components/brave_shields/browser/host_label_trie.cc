@@ -0,0 +1,95 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/host_label_trie.h"
+
+#include <algorithm>
+
+namespace {
+
+// Splits the last label off |host|, which keeps everything before its dot.
+base::StringPiece PopLastLabel(base::StringPiece* host) {
+  size_t dot = host->rfind('.');
+  if (dot == base::StringPiece::npos) {
+    base::StringPiece label = *host;
+    *host = base::StringPiece();
+    return label;
+  }
+  base::StringPiece label = host->substr(dot + 1);
+  *host = host->substr(0, dot);
+  return label;
+}
+
+bool LabelLess(const std::pair<std::string, size_t>& child,
+               base::StringPiece label) {
+  return base::StringPiece(child.first) < label;
+}
+
+}  // namespace
+
+namespace brave_shields {
+
+HostLabelTrie::Node::Node() : terminal(false) {
+}
+
+HostLabelTrie::Node::Node(Node&& other) = default;
+
+HostLabelTrie::Node::~Node() {
+}
+
+HostLabelTrie::HostLabelTrie() {
+  nodes_.emplace_back();
+}
+
+HostLabelTrie::~HostLabelTrie() {
+}
+
+void HostLabelTrie::Add(base::StringPiece host) {
+  if (host.empty()) {
+    return;
+  }
+  size_t node = 0;
+  while (!host.empty()) {
+    base::StringPiece label = PopLastLabel(&host);
+    size_t child = FindChild(node, label);
+    if (!child) {
+      child = nodes_.size();
+      nodes_.emplace_back();
+      auto& children = nodes_[node].children;
+      children.insert(
+          std::lower_bound(children.begin(), children.end(), label,
+                           LabelLess),
+          std::make_pair(label.as_string(), child));
+    }
+    node = child;
+  }
+  nodes_[node].terminal = true;
+}
+
+bool HostLabelTrie::Matches(base::StringPiece host,
+                            bool include_subdomains) const {
+  size_t node = 0;
+  while (!host.empty()) {
+    node = FindChild(node, PopLastLabel(&host));
+    if (!node) {
+      return false;
+    }
+    if (nodes_[node].terminal && (include_subdomains || host.empty())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+size_t HostLabelTrie::FindChild(size_t node, base::StringPiece label) const {
+  const auto& children = nodes_[node].children;
+  auto it = std::lower_bound(children.begin(), children.end(), label,
+                             LabelLess);
+  if (it == children.end() || it->first != label) {
+    return 0;
+  }
+  return it->second;
+}
+
+}  // namespace brave_shields
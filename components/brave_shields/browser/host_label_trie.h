@@ -0,0 +1,57 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HOST_LABEL_TRIE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HOST_LABEL_TRIE_H_
+
+#include <stddef.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/strings/string_piece.h"
+
+namespace brave_shields {
+
+// A set of hosts stored as a trie of their labels, last label first, so that
+// "www.example.com" is found by walking "com", "example", "www". Checking
+// whether a host or one of its parent domains is in the set is a single walk
+// over its labels which allocates nothing. Not thread safe while being built,
+// safe to read from any thread afterwards.
+class HostLabelTrie {
+ public:
+  HostLabelTrie();
+  ~HostLabelTrie();
+
+  void Add(base::StringPiece host);
+
+  // Returns true if |host| was added. When |include_subdomains| is true, also
+  // returns true if |host| is a subdomain of an added host.
+  bool Matches(base::StringPiece host, bool include_subdomains) const;
+
+ private:
+  struct Node {
+    Node();
+    Node(Node&& other);
+    ~Node();
+
+    bool terminal;
+    // Child node indexes, sorted by label.
+    std::vector<std::pair<std::string, size_t>> children;
+  };
+
+  // Returns the index of the child of |node| for |label|, or 0 if there is
+  // none. The root is never anybody's child.
+  size_t FindChild(size_t node, base::StringPiece label) const;
+
+  std::vector<Node> nodes_;
+
+  DISALLOW_COPY_AND_ASSIGN(HostLabelTrie);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HOST_LABEL_TRIE_H_
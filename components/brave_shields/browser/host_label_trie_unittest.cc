@@ -0,0 +1,51 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/host_label_trie.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+using brave_shields::HostLabelTrie;
+
+TEST(HostLabelTrieTest, ExactMatch) {
+  HostLabelTrie trie;
+  trie.Add("www.facebook.com");
+  trie.Add("pbs.twimg.com");
+  EXPECT_TRUE(trie.Matches("www.facebook.com", false));
+  EXPECT_TRUE(trie.Matches("pbs.twimg.com", false));
+  EXPECT_FALSE(trie.Matches("facebook.com", false));
+  EXPECT_FALSE(trie.Matches("a.www.facebook.com", false));
+  EXPECT_FALSE(trie.Matches("twimg.com", false));
+  EXPECT_FALSE(trie.Matches("", false));
+}
+
+TEST(HostLabelTrieTest, SubdomainMatch) {
+  HostLabelTrie trie;
+  trie.Add("fbcdn.net");
+  EXPECT_TRUE(trie.Matches("fbcdn.net", true));
+  EXPECT_TRUE(trie.Matches("scontent.xx.fbcdn.net", true));
+  EXPECT_FALSE(trie.Matches("net", true));
+  EXPECT_FALSE(trie.Matches("notfbcdn.net", true));
+  EXPECT_FALSE(trie.Matches("fbcdn.net.evil.com", true));
+  EXPECT_FALSE(trie.Matches("fbcdn.network", true));
+}
+
+TEST(HostLabelTrieTest, SharedSuffixes) {
+  HostLabelTrie trie;
+  trie.Add("a.example.com");
+  trie.Add("b.example.com");
+  trie.Add("example.org");
+  EXPECT_TRUE(trie.Matches("a.example.com", true));
+  EXPECT_TRUE(trie.Matches("x.b.example.com", true));
+  EXPECT_FALSE(trie.Matches("c.example.com", true));
+  EXPECT_FALSE(trie.Matches("example.com", true));
+  EXPECT_TRUE(trie.Matches("www.example.org", true));
+}
+
+TEST(HostLabelTrieTest, Empty) {
+  HostLabelTrie trie;
+  trie.Add("");
+  EXPECT_FALSE(trie.Matches("example.com", true));
+  EXPECT_FALSE(trie.Matches("", true));
+}
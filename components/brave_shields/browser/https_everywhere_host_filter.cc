@@ -0,0 +1,60 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_host_filter.h"
+
+#include <algorithm>
+
+#define HTTPSE_HOST_FILTER_BITS_PER_KEY  10
+#define HTTPSE_HOST_FILTER_HASH_COUNT    7
+
+namespace {
+
+// 64-bit FNV-1a. Its two halves seed the double hashing below.
+uint64_t HashKey(base::StringPiece key) {
+  uint64_t hash = 14695981039346656037ull;
+  for (char c : key) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+}  // namespace
+
+namespace brave_shields {
+
+HTTPSEHostFilter::HTTPSEHostFilter(size_t expected_keys)
+    : bit_count_(std::max<uint64_t>(
+          64, expected_keys * HTTPSE_HOST_FILTER_BITS_PER_KEY)) {
+  bits_.resize((bit_count_ + 63) / 64);
+}
+
+HTTPSEHostFilter::~HTTPSEHostFilter() {
+}
+
+void HTTPSEHostFilter::Add(base::StringPiece key) {
+  uint64_t hash = HashKey(key);
+  uint32_t h1 = static_cast<uint32_t>(hash);
+  uint32_t h2 = static_cast<uint32_t>(hash >> 32) | 1;
+  for (uint32_t i = 0; i < HTTPSE_HOST_FILTER_HASH_COUNT; i++) {
+    uint64_t bit = (h1 + static_cast<uint64_t>(i) * h2) % bit_count_;
+    bits_[bit / 64] |= 1ull << (bit % 64);
+  }
+}
+
+bool HTTPSEHostFilter::MayContain(base::StringPiece key) const {
+  uint64_t hash = HashKey(key);
+  uint32_t h1 = static_cast<uint32_t>(hash);
+  uint32_t h2 = static_cast<uint32_t>(hash >> 32) | 1;
+  for (uint32_t i = 0; i < HTTPSE_HOST_FILTER_HASH_COUNT; i++) {
+    uint64_t bit = (h1 + static_cast<uint64_t>(i) * h2) % bit_count_;
+    if (!(bits_[bit / 64] & (1ull << (bit % 64)))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace brave_shields
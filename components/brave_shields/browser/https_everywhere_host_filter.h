@@ -0,0 +1,45 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_HOST_FILTER_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_HOST_FILTER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/strings/string_piece.h"
+
+namespace brave_shields {
+
+// Bloom filter over the lookup keys of the HTTPS Everywhere database,
+// including their wildcard forms ("com.digg.*"). It answers "definitely no
+// ruleset" without touching the database, so most http:// requests can be
+// let through on the IO thread. The filter is immutable once built.
+class HTTPSEHostFilter : public base::RefCountedThreadSafe<HTTPSEHostFilter> {
+ public:
+  // Sizes the filter for |expected_keys| entries at roughly a 1% false
+  // positive rate.
+  explicit HTTPSEHostFilter(size_t expected_keys);
+
+  void Add(base::StringPiece key);
+  // False means |key| was never added. True may be a false positive.
+  bool MayContain(base::StringPiece key) const;
+
+ private:
+  friend class base::RefCountedThreadSafe<HTTPSEHostFilter>;
+  ~HTTPSEHostFilter();
+
+  std::vector<uint64_t> bits_;
+  uint64_t bit_count_;
+
+  DISALLOW_COPY_AND_ASSIGN(HTTPSEHostFilter);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_HOST_FILTER_H_
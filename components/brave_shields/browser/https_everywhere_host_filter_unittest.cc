@@ -0,0 +1,40 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_host_filter.h"
+
+#include "base/strings/string_number_conversions.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using brave_shields::HTTPSEHostFilter;
+
+TEST(HTTPSEHostFilterTest, NoFalseNegatives) {
+  scoped_refptr<HTTPSEHostFilter> filter(new HTTPSEHostFilter(1000));
+  for (int i = 0; i < 1000; i++) {
+    filter->Add("com.example" + base::IntToString(i) + ".*");
+  }
+  for (int i = 0; i < 1000; i++) {
+    EXPECT_TRUE(filter->MayContain("com.example" + base::IntToString(i) + ".*"));
+  }
+}
+
+TEST(HTTPSEHostFilterTest, FewFalsePositives) {
+  scoped_refptr<HTTPSEHostFilter> filter(new HTTPSEHostFilter(1000));
+  for (int i = 0; i < 1000; i++) {
+    filter->Add("com.example" + base::IntToString(i));
+  }
+  int false_positives = 0;
+  for (int i = 0; i < 10000; i++) {
+    if (filter->MayContain("org.other" + base::IntToString(i))) {
+      false_positives++;
+    }
+  }
+  // ~1% expected, leave plenty of room.
+  EXPECT_LT(false_positives, 500);
+}
+
+TEST(HTTPSEHostFilterTest, Empty) {
+  scoped_refptr<HTTPSEHostFilter> filter(new HTTPSEHostFilter(0));
+  EXPECT_FALSE(filter->MayContain("com.digg.www"));
+}
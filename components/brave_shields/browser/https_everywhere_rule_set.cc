@@ -0,0 +1,186 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_rule_set.h"
+
+#include <utility>
+
+#include "base/json/json_reader.h"
+#include "base/values.h"
+#include "third_party/re2/src/re2/re2.h"
+
+namespace brave_shields {
+
+HTTPSERuleSet::Rule::Rule() : upgrade_scheme_only(false) {
+}
+
+HTTPSERuleSet::Rule::Rule(Rule&& other) = default;
+
+HTTPSERuleSet::Rule::~Rule() {
+}
+
+HTTPSERuleSet::Target::Target() : has_rules(false) {
+}
+
+HTTPSERuleSet::Target::Target(Target&& other) = default;
+
+HTTPSERuleSet::Target::~Target() {
+}
+
+HTTPSERuleSet::HTTPSERuleSet() {
+}
+
+HTTPSERuleSet::~HTTPSERuleSet() {
+}
+
+// static
+scoped_refptr<HTTPSERuleSet> HTTPSERuleSet::Parse(base::StringPiece json) {
+  std::unique_ptr<base::Value> json_object = base::JSONReader::Read(json);
+  if (nullptr == json_object.get()) {
+    return nullptr;
+  }
+
+  const base::ListValue* topValues = nullptr;
+  json_object->GetAsList(&topValues);
+  if (nullptr == topValues) {
+    return nullptr;
+  }
+
+  scoped_refptr<HTTPSERuleSet> rule_set(new HTTPSERuleSet());
+  for (size_t i = 0; i < topValues->GetSize(); ++i) {
+    const base::Value* childTopValue = nullptr;
+    if (!topValues->Get(i, &childTopValue)) {
+      continue;
+    }
+    const base::DictionaryValue* childTopDictionary = nullptr;
+    childTopValue->GetAsDictionary(&childTopDictionary);
+    if (nullptr == childTopDictionary) {
+      continue;
+    }
+
+    Target target;
+    const base::Value* exclusion = nullptr;
+    if (childTopDictionary->Get("e", &exclusion)) {
+      const base::ListValue* eValues = nullptr;
+      exclusion->GetAsList(&eValues);
+      if (nullptr != eValues) {
+        for (size_t j = 0; j < eValues->GetSize(); ++j) {
+          const base::Value* pValue = nullptr;
+          if (!eValues->Get(j, &pValue)) {
+            continue;
+          }
+          const base::DictionaryValue* pDictionary = nullptr;
+          pValue->GetAsDictionary(&pDictionary);
+          if (nullptr == pDictionary) {
+            continue;
+          }
+          const base::Value* patternValue = nullptr;
+          if (!pDictionary->Get("p", &patternValue)) {
+            continue;
+          }
+          std::string pattern;
+          if (!patternValue->GetAsString(&pattern)) {
+            continue;
+          }
+          std::unique_ptr<re2::RE2> regExp(
+              new re2::RE2(CorrecttoRuleToRE2Engine(pattern)));
+          if (!regExp->ok()) {
+            continue;
+          }
+          target.exclusions.push_back(std::move(regExp));
+        }
+      }
+    }
+
+    const base::Value* rules = nullptr;
+    const base::ListValue* rValues = nullptr;
+    if (childTopDictionary->Get("r", &rules)) {
+      rules->GetAsList(&rValues);
+    }
+    target.has_rules = nullptr != rValues;
+    if (!target.has_rules) {
+      // Nothing after a ruleset without rules can ever be reached.
+      rule_set->targets_.push_back(std::move(target));
+      break;
+    }
+
+    for (size_t j = 0; j < rValues->GetSize(); ++j) {
+      const base::Value* pValue = nullptr;
+      if (!rValues->Get(j, &pValue)) {
+        continue;
+      }
+      const base::DictionaryValue* pDictionary = nullptr;
+      pValue->GetAsDictionary(&pDictionary);
+      if (nullptr == pDictionary) {
+        continue;
+      }
+      Rule rule;
+      const base::Value* patternValue = nullptr;
+      if (pDictionary->Get("d", &patternValue)) {
+        rule.upgrade_scheme_only = true;
+        target.rules.push_back(std::move(rule));
+        // A default rule always applies, later rules are never reached.
+        break;
+      }
+
+      const base::Value* from_value = nullptr;
+      const base::Value* to_value = nullptr;
+      if (!pDictionary->Get("f", &from_value) ||
+          !pDictionary->Get("t", &to_value)) {
+        continue;
+      }
+      std::string from, to;
+      if (!from_value->GetAsString(&from) ||
+          !to_value->GetAsString(&to)) {
+        continue;
+      }
+      rule.from.reset(new re2::RE2(from));
+      if (!rule.from->ok()) {
+        continue;
+      }
+      rule.to = CorrecttoRuleToRE2Engine(to);
+      target.rules.push_back(std::move(rule));
+    }
+    rule_set->targets_.push_back(std::move(target));
+  }
+  return rule_set;
+}
+
+std::string HTTPSERuleSet::Apply(const std::string& original_url) const {
+  for (const Target& target : targets_) {
+    for (const auto& exclusion : target.exclusions) {
+      if (re2::RE2::FullMatch(original_url, *exclusion)) {
+        return "";
+      }
+    }
+    if (!target.has_rules) {
+      return "";
+    }
+    for (const Rule& rule : target.rules) {
+      std::string newUrl(original_url);
+      if (rule.upgrade_scheme_only) {
+        return newUrl.insert(4, "s");
+      }
+      if (re2::RE2::Replace(&newUrl, *rule.from, rule.to) &&
+          newUrl != original_url) {
+        return newUrl;
+      }
+    }
+  }
+  return "";
+}
+
+// static
+std::string HTTPSERuleSet::CorrecttoRuleToRE2Engine(const std::string& to) {
+  std::string correctedto(to);
+  size_t pos = to.find("$");
+  while (std::string::npos != pos) {
+    correctedto[pos] = '\\';
+    pos = correctedto.find("$");
+  }
+
+  return correctedto;
+}
+
+}  // namespace brave_shields
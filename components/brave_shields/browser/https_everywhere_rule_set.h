@@ -0,0 +1,72 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULE_SET_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULE_SET_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/strings/string_piece.h"
+
+namespace re2 {
+class RE2;
+}
+
+namespace brave_shields {
+
+// The rulesets stored for one lookup domain of the HTTPS Everywhere database,
+// parsed from their JSON form and with all of their regular expressions
+// compiled. Instances are immutable once created, so they can be shared
+// between the IO thread and the blocking pool without locking.
+class HTTPSERuleSet : public base::RefCountedThreadSafe<HTTPSERuleSet> {
+ public:
+  // Returns nullptr if |json| is not a list of rulesets.
+  static scoped_refptr<HTTPSERuleSet> Parse(base::StringPiece json);
+
+  // Returns the rewritten URL, or an empty string if no rule applies.
+  std::string Apply(const std::string& original_url) const;
+
+  // The engine stores backreferences as $1, RE2 wants \1.
+  static std::string CorrecttoRuleToRE2Engine(const std::string& to);
+
+ private:
+  friend class base::RefCountedThreadSafe<HTTPSERuleSet>;
+
+  struct Rule {
+    Rule();
+    Rule(Rule&& other);
+    ~Rule();
+
+    // A "d" (default) rule upgrades the scheme without a regex.
+    bool upgrade_scheme_only;
+    std::unique_ptr<re2::RE2> from;
+    std::string to;
+  };
+
+  struct Target {
+    Target();
+    Target(Target&& other);
+    ~Target();
+
+    std::vector<std::unique_ptr<re2::RE2>> exclusions;
+    // False if the ruleset had no usable "r" list, which stops the lookup.
+    bool has_rules;
+    std::vector<Rule> rules;
+  };
+
+  HTTPSERuleSet();
+  ~HTTPSERuleSet();
+
+  std::vector<Target> targets_;
+
+  DISALLOW_COPY_AND_ASSIGN(HTTPSERuleSet);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULE_SET_H_
@@ -0,0 +1,47 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_rule_set.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using brave_shields::HTTPSERuleSet;
+
+TEST(HTTPSERuleSetTest, InvalidJSON) {
+  EXPECT_FALSE(HTTPSERuleSet::Parse("not json"));
+  EXPECT_FALSE(HTTPSERuleSet::Parse("{\"r\": []}"));
+}
+
+TEST(HTTPSERuleSetTest, DefaultRuleUpgradesScheme) {
+  scoped_refptr<HTTPSERuleSet> rule_set =
+      HTTPSERuleSet::Parse("[{\"r\": [{\"d\": 1}]}]");
+  ASSERT_TRUE(rule_set);
+  EXPECT_EQ("https://www.digg.com/", rule_set->Apply("http://www.digg.com/"));
+}
+
+TEST(HTTPSERuleSetTest, RewritesWithBackreferences) {
+  scoped_refptr<HTTPSERuleSet> rule_set = HTTPSERuleSet::Parse(
+      "[{\"r\": [{\"f\": \"^http://(www\\\\.)?example\\\\.com/\","
+      "\"t\": \"https://$1example.com/\"}]}]");
+  ASSERT_TRUE(rule_set);
+  EXPECT_EQ("https://www.example.com/a",
+            rule_set->Apply("http://www.example.com/a"));
+  EXPECT_EQ("https://example.com/", rule_set->Apply("http://example.com/"));
+  EXPECT_EQ("", rule_set->Apply("http://example.org/"));
+}
+
+TEST(HTTPSERuleSetTest, ExclusionsWin) {
+  scoped_refptr<HTTPSERuleSet> rule_set = HTTPSERuleSet::Parse(
+      "[{\"e\": [{\"p\": \"^http://example\\\\.com/plain/.*\"}],"
+      "\"r\": [{\"d\": 1}]}]");
+  ASSERT_TRUE(rule_set);
+  EXPECT_EQ("", rule_set->Apply("http://example.com/plain/page"));
+  EXPECT_EQ("https://example.com/other",
+            rule_set->Apply("http://example.com/other"));
+}
+
+TEST(HTTPSERuleSetTest, CorrecttoRuleToRE2Engine) {
+  EXPECT_EQ("https://\\1example.com/\\2",
+            HTTPSERuleSet::CorrecttoRuleToRE2Engine(
+                "https://$1example.com/$2"));
+}
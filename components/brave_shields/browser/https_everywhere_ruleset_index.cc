@@ -0,0 +1,163 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_ruleset_index.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/logging.h"
+
+#define HTTPSE_RULESET_INDEX_MAGIC    0x45535448  // "HTSE"
+#define HTTPSE_RULESET_INDEX_VERSION  1
+
+namespace brave_shields {
+
+namespace {
+
+struct Header {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t count;
+  uint32_t reserved;
+};
+
+}  // namespace
+
+struct HTTPSERulesetIndex::Entry {
+  uint32_t key_offset;
+  uint32_t key_length;
+  uint32_t value_offset;
+  uint32_t value_length;
+};
+
+HTTPSERulesetIndex::HTTPSERulesetIndex()
+    : data_(nullptr),
+      length_(0),
+      entries_(nullptr),
+      count_(0) {
+}
+
+HTTPSERulesetIndex::~HTTPSERulesetIndex() {
+}
+
+// static
+scoped_refptr<HTTPSERulesetIndex> HTTPSERulesetIndex::Load(
+    const base::FilePath& file_path) {
+  scoped_refptr<HTTPSERulesetIndex> index(new HTTPSERulesetIndex());
+  index->file_.reset(new base::MemoryMappedFile());
+  if (!index->file_->Initialize(file_path)) {
+    LOG(ERROR) << "Failed to map HTTPSE ruleset file " << file_path.value();
+    return nullptr;
+  }
+  if (!index->Init(index->file_->data(), index->file_->length())) {
+    LOG(ERROR) << "Invalid HTTPSE ruleset file " << file_path.value();
+    return nullptr;
+  }
+  return index;
+}
+
+// static
+scoped_refptr<HTTPSERulesetIndex> HTTPSERulesetIndex::CreateFromBuffer(
+    std::string buffer) {
+  scoped_refptr<HTTPSERulesetIndex> index(new HTTPSERulesetIndex());
+  index->buffer_ = std::move(buffer);
+  if (!index->Init(reinterpret_cast<const uint8_t*>(index->buffer_.data()),
+                   index->buffer_.size())) {
+    return nullptr;
+  }
+  return index;
+}
+
+// static
+void HTTPSERulesetIndex::Serialize(
+    const std::map<std::string, std::string>& rulesets,
+    std::string* output) {
+  Header header;
+  header.magic = HTTPSE_RULESET_INDEX_MAGIC;
+  header.version = HTTPSE_RULESET_INDEX_VERSION;
+  header.count = rulesets.size();
+  header.reserved = 0;
+
+  std::vector<Entry> entries;
+  entries.reserve(rulesets.size());
+  std::string pool;
+  uint32_t pool_start = sizeof(Header) + sizeof(Entry) * rulesets.size();
+  // std::map iterates in key order, which is the order Find() relies on.
+  for (const auto& ruleset : rulesets) {
+    Entry entry;
+    entry.key_offset = pool_start + pool.size();
+    entry.key_length = ruleset.first.size();
+    pool.append(ruleset.first);
+    entry.value_offset = pool_start + pool.size();
+    entry.value_length = ruleset.second.size();
+    pool.append(ruleset.second);
+    entries.push_back(entry);
+  }
+
+  output->clear();
+  output->reserve(pool_start + pool.size());
+  output->append(reinterpret_cast<const char*>(&header), sizeof(header));
+  if (!entries.empty()) {
+    output->append(reinterpret_cast<const char*>(&entries.front()),
+                   sizeof(Entry) * entries.size());
+  }
+  output->append(pool);
+}
+
+bool HTTPSERulesetIndex::Init(const uint8_t* data, size_t length) {
+  if (length < sizeof(Header)) {
+    return false;
+  }
+  const Header* header = reinterpret_cast<const Header*>(data);
+  if (header->magic != HTTPSE_RULESET_INDEX_MAGIC ||
+      header->version != HTTPSE_RULESET_INDEX_VERSION ||
+      header->count > (length - sizeof(Header)) / sizeof(Entry)) {
+    return false;
+  }
+  const Entry* entries = reinterpret_cast<const Entry*>(data + sizeof(Header));
+  for (uint32_t i = 0; i < header->count; ++i) {
+    const Entry& entry = entries[i];
+    if (entry.key_offset > length ||
+        entry.key_length > length - entry.key_offset ||
+        entry.value_offset > length ||
+        entry.value_length > length - entry.value_offset) {
+      return false;
+    }
+  }
+
+  data_ = data;
+  length_ = length;
+  entries_ = entries;
+  count_ = header->count;
+  return true;
+}
+
+base::StringPiece HTTPSERulesetIndex::KeyAt(size_t i) const {
+  DCHECK_LT(i, count_);
+  return base::StringPiece(
+      reinterpret_cast<const char*>(data_ + entries_[i].key_offset),
+      entries_[i].key_length);
+}
+
+base::StringPiece HTTPSERulesetIndex::Find(base::StringPiece key) const {
+  const Entry* end = entries_ + count_;
+  const Entry* it = std::lower_bound(entries_, end, key,
+      [this](const Entry& entry, base::StringPiece key) {
+        return base::StringPiece(
+            reinterpret_cast<const char*>(data_ + entry.key_offset),
+            entry.key_length) < key;
+      });
+  if (it == end || KeyAt(it - entries_) != key) {
+    return base::StringPiece();
+  }
+  return base::StringPiece(
+      reinterpret_cast<const char*>(data_ + it->value_offset),
+      it->value_length);
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,79 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULESET_INDEX_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULESET_INDEX_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/strings/string_piece.h"
+
+namespace base {
+class FilePath;
+class MemoryMappedFile;
+}
+
+namespace brave_shields {
+
+// Read-only view over the flat HTTPS Everywhere ruleset file.
+//
+// The file holds a header, a table of entries sorted by lookup key and a
+// string pool. Lookup keys are the reversed domains used by the LevelDB
+// database ("com.digg.www", "com.digg.*") and values are the serialized
+// rulesets for that key, so a lookup is a binary search over the mapped
+// bytes without any copy or unzip step. The index is immutable, so once
+// loaded it can be read from any thread.
+class HTTPSERulesetIndex
+    : public base::RefCountedThreadSafe<HTTPSERulesetIndex> {
+ public:
+  // Memory maps |file_path|. Returns nullptr if the file is missing or is
+  // not a valid ruleset file of the current version.
+  static scoped_refptr<HTTPSERulesetIndex> Load(
+      const base::FilePath& file_path);
+  // Takes ownership of an already serialized index.
+  static scoped_refptr<HTTPSERulesetIndex> CreateFromBuffer(
+      std::string buffer);
+
+  // Serializes |rulesets|, a map from lookup key to ruleset JSON, into
+  // |output| in the format read by this class.
+  static void Serialize(const std::map<std::string, std::string>& rulesets,
+                        std::string* output);
+
+  // Returns the serialized rulesets for |key|, or an empty piece if there
+  // are none. The result points into the index and lives as long as it.
+  base::StringPiece Find(base::StringPiece key) const;
+
+  size_t size() const { return count_; }
+  // Returns the lookup key of the |i|th entry, in sorted order.
+  base::StringPiece KeyAt(size_t i) const;
+
+ private:
+  friend class base::RefCountedThreadSafe<HTTPSERulesetIndex>;
+  struct Entry;
+
+  HTTPSERulesetIndex();
+  ~HTTPSERulesetIndex();
+  bool Init(const uint8_t* data, size_t length);
+
+  std::unique_ptr<base::MemoryMappedFile> file_;
+  std::string buffer_;
+
+  const uint8_t* data_;
+  size_t length_;
+  const Entry* entries_;
+  uint32_t count_;
+
+  DISALLOW_COPY_AND_ASSIGN(HTTPSERulesetIndex);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULESET_INDEX_H_
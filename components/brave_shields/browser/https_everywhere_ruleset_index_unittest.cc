@@ -0,0 +1,48 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_ruleset_index.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using brave_shields::HTTPSERulesetIndex;
+
+TEST(HTTPSERulesetIndexTest, RoundTrip) {
+  std::map<std::string, std::string> rulesets({
+    { "com.digg.www", "[{\"r\": [{\"d\": 1}]}]" },
+    { "com.digg.*", "[]" },
+    { "org.example", "[{}]" }
+  });
+  std::string buffer;
+  HTTPSERulesetIndex::Serialize(rulesets, &buffer);
+  scoped_refptr<HTTPSERulesetIndex> index =
+      HTTPSERulesetIndex::CreateFromBuffer(buffer);
+  ASSERT_TRUE(index);
+  EXPECT_EQ(3u, index->size());
+  for (const auto& ruleset : rulesets) {
+    EXPECT_EQ(ruleset.second, index->Find(ruleset.first));
+  }
+  EXPECT_TRUE(index->Find("com.digg").empty());
+  EXPECT_TRUE(index->Find("net.example").empty());
+  EXPECT_TRUE(index->Find("").empty());
+}
+
+TEST(HTTPSERulesetIndexTest, Empty) {
+  std::string buffer;
+  HTTPSERulesetIndex::Serialize(std::map<std::string, std::string>(), &buffer);
+  scoped_refptr<HTTPSERulesetIndex> index =
+      HTTPSERulesetIndex::CreateFromBuffer(buffer);
+  ASSERT_TRUE(index);
+  EXPECT_EQ(0u, index->size());
+  EXPECT_TRUE(index->Find("com.digg.www").empty());
+}
+
+TEST(HTTPSERulesetIndexTest, RejectsCorruptData) {
+  EXPECT_FALSE(HTTPSERulesetIndex::CreateFromBuffer(""));
+  EXPECT_FALSE(HTTPSERulesetIndex::CreateFromBuffer("not a ruleset file"));
+
+  std::string buffer;
+  HTTPSERulesetIndex::Serialize({{ "com.digg.www", "[]" }}, &buffer);
+  buffer.resize(buffer.size() - 1);
+  EXPECT_FALSE(HTTPSERulesetIndex::CreateFromBuffer(buffer));
+}
@@ -10,23 +10,25 @@
 #include <vector>
 
 #include "base/base_paths.h"
-#include "base/json/json_reader.h"
+#include "base/files/file_util.h"
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/threading/thread_restrictions.h"
-#include "base/values.h"
 #include "brave/components/brave_shields/browser/dat_file_util.h"
+#include "brave/components/brave_shields/browser/https_everywhere_host_filter.h"
+#include "brave/components/brave_shields/browser/https_everywhere_rule_set.h"
+#include "brave/components/brave_shields/browser/https_everywhere_ruleset_index.h"
 #include "chrome/browser/browser_process.h"
 #include "third_party/leveldatabase/src/include/leveldb/db.h"
-#include "third_party/re2/src/re2/re2.h"
 #include "third_party/zlib/google/zip.h"
 
 #define DAT_FILE "httpse.leveldb.zip"
+#define RULESET_INDEX_FILE "httpse.rulesets"
 #define DAT_FILE_VERSION "6.0"
-#define HTTPSE_URLS_REDIRECTS_COUNT_QUEUE   1
-#define HTTPSE_URL_MAX_REDIRECTS_COUNT      5
+#define HTTPSE_RULE_SETS_CACHE_SIZE         1000
+#define HTTPSE_RECENTLY_USED_CACHE_SIZE     5000
 
 namespace {
   std::vector<std::string> Split(const std::string& s, char delim) {
@@ -76,13 +78,40 @@ namespace {
 
 namespace brave_shields {
 
+// Owns an open LevelDB database, so that lookups on the blocking pool keep
+// it alive while the task runner swaps in a new one.
+class HTTPSELevelDB : public base::RefCountedThreadSafe<HTTPSELevelDB> {
+ public:
+  explicit HTTPSELevelDB(std::unique_ptr<leveldb::DB> db)
+      : db_(std::move(db)) {}
+
+  leveldb::DB* db() const { return db_.get(); }
+
+ private:
+  friend class base::RefCountedThreadSafe<HTTPSELevelDB>;
+
+  ~HTTPSELevelDB() {}
+
+  std::unique_ptr<leveldb::DB> db_;
+
+  DISALLOW_COPY_AND_ASSIGN(HTTPSELevelDB);
+};
+
 bool HTTPSEverywhereService::g_ignore_port_for_test_(false);
 std::string HTTPSEverywhereService::g_https_everywhere_component_id_(
     kHTTPSEverywhereComponentId);
 std::string HTTPSEverywhereService::g_https_everywhere_component_base64_public_key_(
     kHTTPSEverywhereComponentBase64PublicKey);
 
-HTTPSEverywhereService::HTTPSEverywhereService() : level_db_(nullptr) {
+HTTPSEverywhereService::HTTPSEverywhereService()
+    : HTTPSEverywhereService(HTTPSE_RECENTLY_USED_CACHE_SIZE) {
+}
+
+HTTPSEverywhereService::HTTPSEverywhereService(size_t recently_used_cache_size)
+    : recently_used_cache_(recently_used_cache_size),
+      rule_sets_cache_(HTTPSE_RULE_SETS_CACHE_SIZE),
+      rule_sets_generation_(0),
+      generation_(0) {
 }
 
 HTTPSEverywhereService::~HTTPSEverywhereService() {
@@ -103,6 +132,21 @@ bool HTTPSEverywhereService::Init() {
 }
 
 void HTTPSEverywhereService::InitDB(const base::FilePath& install_dir) {
+  // The old database keeps serving lookups until the new one is complete.
+  base::FilePath ruleset_index_path =
+      install_dir.AppendASCII(DAT_FILE_VERSION).AppendASCII(RULESET_INDEX_FILE);
+  if (base::PathExists(ruleset_index_path)) {
+    scoped_refptr<HTTPSERulesetIndex> ruleset_index =
+        HTTPSERulesetIndex::Load(ruleset_index_path);
+    if (ruleset_index) {
+      scoped_refptr<HTTPSEHostFilter> host_filter =
+          BuildHostFilter(ruleset_index.get(), nullptr);
+      PublishDatabase(std::move(ruleset_index), nullptr,
+                      std::move(host_filter));
+      return;
+    }
+  }
+
   base::FilePath zip_db_file_path =
       install_dir.AppendASCII(DAT_FILE_VERSION).AppendASCII(DAT_FILE);
   base::FilePath unzipped_level_db_path = zip_db_file_path.RemoveExtension();
@@ -113,20 +157,111 @@ void HTTPSEverywhereService::InitDB(const base::FilePath& install_dir) {
     return;
   }
 
-  CloseDatabase();
-
   leveldb::Options options;
+  leveldb::DB* db = nullptr;
   leveldb::Status status =
       leveldb::DB::Open(options,
                         unzipped_level_db_path.AsUTF8Unsafe(),
-                        &level_db_);
-  if (!status.ok() || !level_db_) {
+                        &db);
+  if (!status.ok() || !db) {
     LOG(ERROR) << "Level db open error "
                << unzipped_level_db_path.value().c_str()
                << ", error: " << status.ToString();
-    CloseDatabase();
+    delete db;
     return;
   }
+  scoped_refptr<HTTPSELevelDB> level_db(
+      new HTTPSELevelDB(base::WrapUnique(db)));
+  scoped_refptr<HTTPSEHostFilter> host_filter =
+      BuildHostFilter(nullptr, level_db.get());
+  PublishDatabase(nullptr, std::move(level_db), std::move(host_filter));
+}
+
+scoped_refptr<HTTPSEHostFilter> HTTPSEverywhereService::BuildHostFilter(
+    const HTTPSERulesetIndex* ruleset_index,
+    HTTPSELevelDB* level_db) {
+  if (ruleset_index) {
+    scoped_refptr<HTTPSEHostFilter> host_filter(
+        new HTTPSEHostFilter(ruleset_index->size()));
+    for (size_t i = 0; i < ruleset_index->size(); i++) {
+      host_filter->Add(ruleset_index->KeyAt(i));
+    }
+    return host_filter;
+  }
+
+  if (!level_db) {
+    return nullptr;
+  }
+  std::vector<std::string> level_db_keys;
+  std::unique_ptr<leveldb::Iterator> it(
+      level_db->db()->NewIterator(leveldb::ReadOptions()));
+  for (it->SeekToFirst(); it->Valid(); it->Next()) {
+    level_db_keys.push_back(it->key().ToString());
+  }
+  if (!it->status().ok()) {
+    LOG(ERROR) << "Failed to read HTTPSE keys, error: "
+               << it->status().ToString();
+    return nullptr;
+  }
+  scoped_refptr<HTTPSEHostFilter> host_filter(
+      new HTTPSEHostFilter(level_db_keys.size()));
+  for (const auto& key : level_db_keys) {
+    host_filter->Add(key);
+  }
+  return host_filter;
+}
+
+void HTTPSEverywhereService::PublishDatabase(
+    scoped_refptr<HTTPSERulesetIndex> ruleset_index,
+    scoped_refptr<HTTPSELevelDB> level_db,
+    scoped_refptr<HTTPSEHostFilter> host_filter) {
+  int generation;
+  {
+    base::AutoLock lock(index_lock_);
+    std::swap(ruleset_index_, ruleset_index);
+    std::swap(level_db_, level_db);
+    std::swap(host_filter_, host_filter);
+    generation = ++generation_;
+  }
+  // Entries of older generations are ignored by lookups from here on, the
+  // clear only frees them.
+  recently_used_cache_.Clear();
+  base::AutoLock lock(rule_sets_lock_);
+  rule_sets_cache_.Clear();
+  rule_sets_generation_ = generation;
+  // The old database is released once lookups still using it are done.
+}
+
+int HTTPSEverywhereService::GetDatabase(
+    scoped_refptr<HTTPSERulesetIndex>* ruleset_index,
+    scoped_refptr<HTTPSELevelDB>* level_db,
+    scoped_refptr<HTTPSEHostFilter>* host_filter) const {
+  base::AutoLock lock(index_lock_);
+  if (ruleset_index) {
+    *ruleset_index = ruleset_index_;
+  }
+  if (level_db) {
+    *level_db = level_db_;
+  }
+  if (host_filter) {
+    *host_filter = host_filter_;
+  }
+  return generation_;
+}
+
+bool HTTPSEverywhereService::MayHaveRulesForHost(
+    const std::string& host) const {
+  scoped_refptr<HTTPSEHostFilter> host_filter;
+  GetDatabase(nullptr, nullptr, &host_filter);
+  if (!host_filter) {
+    return true;
+  }
+  for (const auto& domain : ExpandDomainForLookup(host)) {
+    if (host_filter->MayContain(domain)) {
+      return true;
+    }
+  }
+  return false;
 }
 
 void HTTPSEverywhereService::OnComponentReady(
@@ -140,19 +275,41 @@ void HTTPSEverywhereService::OnComponentReady(
 }
 
 bool HTTPSEverywhereService::GetHTTPSURL(
-    const GURL* url, const uint64_t& request_identifier,
-    std::string& new_url) {
+    const GURL* url, std::string& new_url) {
   base::AssertBlockingAllowed();
+  GetHTTPSURLInternal(url, true, new_url);
+  return !new_url.empty();
+}
+
+bool HTTPSEverywhereService::GetHTTPSURLFromMemory(
+    const GURL* url, std::string& new_url) {
+  return GetHTTPSURLInternal(url, false, new_url);
+}
+
+bool HTTPSEverywhereService::GetHTTPSURLInternal(
+    const GURL* url,
+    bool allow_blocking,
+    std::string& new_url) {
+  new_url.clear();
   if (!IsInitialized() || url->scheme() == url::kHttpsScheme) {
-    return false;
+    return true;
   }
-  if (!ShouldHTTPSERedirect(request_identifier)) {
-    return false;
+
+  scoped_refptr<HTTPSERulesetIndex> ruleset_index;
+  scoped_refptr<HTTPSELevelDB> level_db;
+  scoped_refptr<HTTPSEHostFilter> host_filter;
+  const int generation =
+      GetDatabase(&ruleset_index, &level_db, &host_filter);
+  // Nothing to look up yet. Nothing is cached either, so the URL is looked
+  // up again once a database is loaded.
+  if (!ruleset_index && !level_db) {
+    return true;
   }
 
-  if (recently_used_cache_.data.count(url->spec()) > 0) {
-    AddHTTPSEUrlToRedirectList(request_identifier);
-    new_url = recently_used_cache_.data[url->spec()];
+  std::pair<int, std::string> cached;
+  if (recently_used_cache_.Get(url->spec(), &cached) &&
+      cached.first == generation) {
+    new_url = cached.second;
     return true;
   }
 
@@ -163,207 +320,88 @@ bool HTTPSEverywhereService::GetHTTPSURL(
     candidate_url = candidate_url.ReplaceComponents(replacements);
   }
 
-  const std::vector<std::string> domains = ExpandDomainForLookup(candidate_url.host());
-  for (auto domain : domains) {
-    std::string value = leveldbGet(level_db_, domain);
-    if (!value.empty()) {
-      new_url = ApplyHTTPSRule(candidate_url.spec(), value);
-      if (0 != new_url.length()) {
-        recently_used_cache_.data[candidate_url.spec()] = new_url;
-        AddHTTPSEUrlToRedirectList(request_identifier);
-        return true;
-      }
-    }
-  }
-  recently_used_cache_.data[candidate_url.spec()].clear();
-  return false;
-}
-
-bool HTTPSEverywhereService::GetHTTPSURLFromCacheOnly(
-    const GURL* url,
-    const uint64_t& request_identifier,
-    std::string& cached_url) {
-  if (!IsInitialized() || url->scheme() == url::kHttpsScheme) {
-    return false;
+  const std::vector<std::string> domains =
+      ExpandDomainForLookup(candidate_url.host());
+  bool may_have_rules = !host_filter;
+  for (size_t i = 0; !may_have_rules && i < domains.size(); i++) {
+    may_have_rules = host_filter->MayContain(domains[i]);
   }
-  if (!ShouldHTTPSERedirect(request_identifier)) {
-    return false;
-  }
-
-  if (recently_used_cache_.data.count(url->spec()) > 0) {
-    AddHTTPSEUrlToRedirectList(request_identifier);
-    cached_url = recently_used_cache_.data[url->spec()];
-    return true;
-  }
-  return false;
-}
-
-bool HTTPSEverywhereService::ShouldHTTPSERedirect(
-    const uint64_t& request_identifier) {
-  std::lock_guard<std::mutex> guard(httpse_get_urls_redirects_count_mutex_);
-  for (size_t i = 0; i < httpse_urls_redirects_count_.size(); i++) {
-    if (request_identifier ==
-        httpse_urls_redirects_count_[i].request_identifier_ &&
-        httpse_urls_redirects_count_[i].redirects_ >=
-        HTTPSE_URL_MAX_REDIRECTS_COUNT - 1) {
-      return false;
+  if (may_have_rules) {
+    for (const auto& domain : domains) {
+      scoped_refptr<HTTPSERuleSet> rule_set;
+      if (!GetRuleSet(domain, generation, ruleset_index.get(),
+                      level_db.get(), allow_blocking, &rule_set)) {
+        // Left to the blocking pool, which compiles the ruleset.
+        return false;
+      }
+      if (rule_set) {
+        new_url = rule_set->Apply(candidate_url.spec());
+        if (0 != new_url.length()) {
+          recently_used_cache_.Add(candidate_url.spec(),
+                                   std::make_pair(generation, new_url));
+          return true;
+        }
+      }
     }
   }
-
+  // Remember that nothing applies so the next request stays on the IO thread.
+  new_url.clear();
+  recently_used_cache_.Add(candidate_url.spec(),
+                           std::make_pair(generation, new_url));
   return true;
 }
 
-void HTTPSEverywhereService::AddHTTPSEUrlToRedirectList(
-    const uint64_t& request_identifier) {
-  // Adding redirects count for the current request
-  std::lock_guard<std::mutex> guard(httpse_get_urls_redirects_count_mutex_);
-  bool hostFound = false;
-  for (size_t i = 0; i < httpse_urls_redirects_count_.size(); i++) {
-    if (request_identifier ==
-        httpse_urls_redirects_count_[i].request_identifier_) {
-      // Found the host, just increment the redirects_count
-      httpse_urls_redirects_count_[i].redirects_++;
-      hostFound = true;
-      break;
-    }
-  }
-  if (!hostFound) {
-      // The host is new, adding it to the redirects list
-      if (httpse_urls_redirects_count_.size() >=
-          HTTPSE_URLS_REDIRECTS_COUNT_QUEUE) {
-          // The queue is full, erase the first element
-          httpse_urls_redirects_count_.erase(
-              httpse_urls_redirects_count_.begin());
+bool HTTPSEverywhereService::GetRuleSet(
+    const std::string& domain,
+    int generation,
+    const HTTPSERulesetIndex* ruleset_index,
+    HTTPSELevelDB* level_db,
+    bool allow_blocking,
+    scoped_refptr<HTTPSERuleSet>* rule_set) {
+  {
+    base::AutoLock lock(rule_sets_lock_);
+    if (rule_sets_generation_ == generation) {
+      auto it = rule_sets_cache_.Get(domain);
+      if (it != rule_sets_cache_.end()) {
+        *rule_set = it->second;
+        return true;
       }
-      httpse_urls_redirects_count_.push_back(
-          HTTPSE_REDIRECTS_COUNT_ST(request_identifier, 1));
+    }
   }
-}
-
-std::string HTTPSEverywhereService::ApplyHTTPSRule(
-    const std::string& originalUrl,
-    const std::string& rule) {
-  std::unique_ptr<base::Value> json_object = base::JSONReader::Read(rule);
-  if (nullptr == json_object.get()) {
-    return "";
+  // Reading the index or LevelDB may wait on disk, and compiling the
+  // rulesets is too slow for the IO thread.
+  if (!allow_blocking) {
+    return false;
   }
 
-  const base::ListValue* topValues = nullptr;
-  json_object->GetAsList(&topValues);
-  if (nullptr == topValues) {
-    return "";
+  // The index hands out pieces of the mapped file, so only the LevelDB
+  // fallback needs a copy of the serialized rulesets.
+  base::StringPiece value;
+  std::string level_db_value;
+  if (ruleset_index) {
+    value = ruleset_index->Find(domain);
+  } else {
+    level_db_value = leveldbGet(level_db->db(), domain);
+    value = level_db_value;
   }
-
-  for (size_t i = 0; i < topValues->GetSize(); ++i) {
-    const base::Value* childTopValue = nullptr;
-    if (!topValues->Get(i, &childTopValue)) {
-      continue;
-    }
-    const base::DictionaryValue* childTopDictionary = nullptr;
-    childTopValue->GetAsDictionary(&childTopDictionary);
-    if (nullptr == childTopDictionary) {
-      continue;
-    }
-
-    const base::Value* exclusion = nullptr;
-    if (childTopDictionary->Get("e", &exclusion)) {
-      const base::ListValue* eValues = nullptr;
-      exclusion->GetAsList(&eValues);
-      if (nullptr != eValues) {
-        for (size_t j = 0; j < eValues->GetSize(); ++j) {
-          const base::Value* pValue = nullptr;
-          if (!eValues->Get(j, &pValue)) {
-            continue;
-          }
-          const base::DictionaryValue* pDictionary = nullptr;
-          pValue->GetAsDictionary(&pDictionary);
-          if (nullptr == pDictionary) {
-            continue;
-          }
-          const base::Value* patternValue = nullptr;
-          if (!pDictionary->Get("p", &patternValue)) {
-            continue;
-          }
-          std::string pattern;
-          if (!patternValue->GetAsString(&pattern)) {
-            continue;
-          }
-          pattern = CorrecttoRuleToRE2Engine(pattern);
-          if (RE2::FullMatch(originalUrl, pattern)) {
-            return "";
-          }
-        }
-      }
-    }
-
-    const base::Value* rules = nullptr;
-    if (!childTopDictionary->Get("r", &rules)) {
-      return "";
-    }
-    const base::ListValue* rValues = nullptr;
-    rules->GetAsList(&rValues);
-    if (nullptr == rValues) {
-      return "";
-    }
-
-    for (size_t j = 0; j < rValues->GetSize(); ++j) {
-      const base::Value* pValue = nullptr;
-      if (!rValues->Get(j, &pValue)) {
-        continue;
-      }
-      const base::DictionaryValue* pDictionary = nullptr;
-      pValue->GetAsDictionary(&pDictionary);
-      if (nullptr == pDictionary) {
-        continue;
-      }
-      const base::Value* patternValue = nullptr;
-      if (pDictionary->Get("d", &patternValue)) {
-        std::string newUrl(originalUrl);
-        return newUrl.insert(4, "s");
-      }
-
-      const base::Value* from_value = nullptr;
-      const base::Value* to_value = nullptr;
-      if (!pDictionary->Get("f", &from_value) ||
-          !pDictionary->Get("t", &to_value)) {
-        continue;
-      }
-      std::string from, to;
-      if (!from_value->GetAsString(&from) ||
-          !to_value->GetAsString(&to)) {
-        continue;
-      }
-
-      to = CorrecttoRuleToRE2Engine(to);
-      std::string newUrl(originalUrl);
-      RE2 regExp(from);
-
-      if (RE2::Replace(&newUrl, regExp, to) && newUrl != originalUrl) {
-        return newUrl;
-      }
-    }
+  // Domains without rulesets, and rulesets which fail to parse, are cached
+  // as nullptr so they are answered from memory from then on.
+  *rule_set = value.empty() ? nullptr : HTTPSERuleSet::Parse(value);
+  base::AutoLock lock(rule_sets_lock_);
+  // A newer database was published meanwhile, whose rulesets may differ.
+  if (rule_sets_generation_ == generation) {
+    rule_sets_cache_.Put(domain, *rule_set);
   }
-  return "";
+  return true;
 }
 
-std::string HTTPSEverywhereService::CorrecttoRuleToRE2Engine(
-    const std::string& to) {
-  std::string correctedto(to);
-  size_t pos = to.find("$");
-  while (std::string::npos != pos) {
-    correctedto[pos] = '\\';
-    pos = correctedto.find("$");
-  }
-
-  return correctedto;
+ShardedLRUCacheStats
+HTTPSEverywhereService::GetRecentlyUsedCacheStats() const {
+  return recently_used_cache_.GetStats();
 }
 
-void HTTPSEverywhereService::CloseDatabase()
-{
-  if (level_db_) {
-    delete level_db_;
-    level_db_ = nullptr;
-  }
+void HTTPSEverywhereService::CloseDatabase() {
+  PublishDatabase(nullptr, nullptr, nullptr);
 }
 
 // static
@@ -9,22 +9,25 @@
 
 #include <memory>
 #include <string>
-#include <vector>
-#include <mutex>
+#include <utility>
 
+#include "base/containers/mru_cache.h"
 #include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
+#include "base/synchronization/lock.h"
 #include "brave/components/brave_shields/browser/base_brave_shields_service.h"
-#include "brave/components/brave_shields/browser/https_everywhere_recently_used_cache.h"
+#include "brave/components/brave_shields/browser/sharded_lru_cache.h"
 #include "content/public/common/resource_type.h"
 
-namespace leveldb {
-class DB;
-}
-
 class HTTPSEverywhereServiceTest;
 
 namespace brave_shields {
 
+class HTTPSEHostFilter;
+class HTTPSELevelDB;
+class HTTPSERuleSet;
+class HTTPSERulesetIndex;
+
 const std::string kHTTPSEverywhereComponentName("Brave HTTPS Everywhere Updater");
 const std::string kHTTPSEverywhereComponentId("oofiananboodjbbmdelgdommihjbkfag");
 
@@ -37,26 +40,28 @@ const std::string kHTTPSEverywhereComponentBase64PublicKey =
     "OtZqgfRg8Da4i+NwmjQqrz0JFtPMMSyUnmeMj+mSOL4xZVWr8fU2/GOCXs9gczDp"
     "JwIDAQAB";
 
-struct HTTPSE_REDIRECTS_COUNT_ST {
-public:
-    HTTPSE_REDIRECTS_COUNT_ST(uint64_t request_identifier,
-        unsigned int redirects):
-      request_identifier_(request_identifier),
-      redirects_(redirects) {
-    }
-
-    uint64_t request_identifier_;
-    unsigned int redirects_;
-};
-
 class HTTPSEverywhereService : public BaseBraveShieldsService {
  public:
    HTTPSEverywhereService();
+   // |recently_used_cache_size| bounds the number of URLs whose result is
+   // remembered.
+   explicit HTTPSEverywhereService(size_t recently_used_cache_size);
    ~HTTPSEverywhereService() override;
-  bool GetHTTPSURL(const GURL* url, const uint64_t& request_id,
-      std::string& new_url);
-  bool GetHTTPSURLFromCacheOnly(const GURL* url,
-      const uint64_t& request_id, std::string& cached_url);
+  // Looks the URL up in the database. Must be called where blocking is
+  // allowed since rulesets are read from disk and compiled on first use.
+  bool GetHTTPSURL(const GURL* url, std::string& new_url);
+  // Answers from memory only: the URL cache, the host filter and the
+  // rulesets compiled by earlier GetHTTPSURL() calls. Never blocks, so it may
+  // be called on the IO thread. Returns false if that is not enough to
+  // decide, GetHTTPSURL() has to be used then. Otherwise |new_url| is the
+  // rewritten URL, or empty if no rule applies.
+  bool GetHTTPSURLFromMemory(const GURL* url, std::string& new_url);
+  // Returns false if no ruleset can apply to |host|, so callers can skip the
+  // database lookup entirely. Cheap enough for the IO thread. Returns true
+  // if no filter could be built for the current database.
+  bool MayHaveRulesForHost(const std::string& host) const;
+  // Hit, miss and eviction counters of the URL cache, for diagnostics.
+  ShardedLRUCacheStats GetRecentlyUsedCacheStats() const;
 
  protected:
   bool Init() override;
@@ -64,11 +69,17 @@ class HTTPSEverywhereService : public BaseBraveShieldsService {
   void OnComponentReady(const std::string& component_id,
       const base::FilePath& install_dir) override;
 
-  void AddHTTPSEUrlToRedirectList(const uint64_t& request_id);
-  bool ShouldHTTPSERedirect(const uint64_t& request_id);
-  std::string ApplyHTTPSRule(const std::string& originalUrl,
-      const std::string& rule);
-  std::string CorrecttoRuleToRE2Engine(const std::string& to);
+  // Sets |rule_set| to the compiled rulesets stored for |domain| in the
+  // database loaded as |generation|, or nullptr if there are none. They are
+  // read and compiled on first use; if that is needed but |allow_blocking|
+  // is false, returns false instead. One of |ruleset_index| and |level_db|
+  // is set.
+  bool GetRuleSet(const std::string& domain,
+                  int generation,
+                  const HTTPSERulesetIndex* ruleset_index,
+                  HTTPSELevelDB* level_db,
+                  bool allow_blocking,
+                  scoped_refptr<HTTPSERuleSet>* rule_set);
 
  private:
   friend class ::HTTPSEverywhereServiceTest;
@@ -83,11 +94,43 @@ class HTTPSEverywhereService : public BaseBraveShieldsService {
   void CloseDatabase();
 
   void InitDB(const base::FilePath& install_dir);
-
-  std::mutex httpse_get_urls_redirects_count_mutex_;
-  std::vector<HTTPSE_REDIRECTS_COUNT_ST> httpse_urls_redirects_count_;
-  HTTPSERecentlyUsedCache<std::string> recently_used_cache_;
-  leveldb::DB* level_db_;
+  scoped_refptr<HTTPSEHostFilter> BuildHostFilter(
+      const HTTPSERulesetIndex* ruleset_index,
+      HTTPSELevelDB* level_db);
+  // Swaps in a fully built database, or none if all are nullptr, and starts
+  // a new generation so that lookups still running against the old one do
+  // not fill the caches.
+  void PublishDatabase(scoped_refptr<HTTPSERulesetIndex> ruleset_index,
+                       scoped_refptr<HTTPSELevelDB> level_db,
+                       scoped_refptr<HTTPSEHostFilter> host_filter);
+  // Takes the current database under |index_lock_| and returns its
+  // generation. Any of the out parameters may be nullptr.
+  int GetDatabase(scoped_refptr<HTTPSERulesetIndex>* ruleset_index,
+                  scoped_refptr<HTTPSELevelDB>* level_db,
+                  scoped_refptr<HTTPSEHostFilter>* host_filter) const;
+  // Returns false if the lookup needs the database but |allow_blocking| is
+  // false. Otherwise |new_url| is the rewritten URL, or empty.
+  bool GetHTTPSURLInternal(const GURL* url,
+                           bool allow_blocking,
+                           std::string& new_url);
+
+  // Rewritten URL by original URL, with the database generation it was
+  // worked out against. An empty URL means no rule applies.
+  ShardedLRUCache<std::pair<int, std::string>> recently_used_cache_;
+  // Guards |rule_sets_cache_|, which is read on the IO thread and filled
+  // from the blocking pool. Domains without rulesets are cached as nullptr.
+  base::Lock rule_sets_lock_;
+  base::MRUCache<std::string, scoped_refptr<HTTPSERuleSet>> rule_sets_cache_;
+  // The generation |rule_sets_cache_| was filled from.
+  int rule_sets_generation_;
+  // Guards the database below, which is replaced on the task runner and
+  // read on the IO thread and the blocking pool.
+  mutable base::Lock index_lock_;
+  int generation_;
+  scoped_refptr<HTTPSERulesetIndex> ruleset_index_;
+  // Only used by older components which do not ship the flat index.
+  scoped_refptr<HTTPSELevelDB> level_db_;
+  scoped_refptr<HTTPSEHostFilter> host_filter_;
 
   DISALLOW_COPY_AND_ASSIGN(HTTPSEverywhereService);
 };
@@ -0,0 +1,112 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/render_frame_tab_url_map.h"
+
+#include <utility>
+
+namespace brave_shields {
+
+RenderFrameTabInfo::RenderFrameTabInfo()
+    : tab_frame_tree_node_id(-1),
+      navigation_id(0) {
+}
+
+RenderFrameTabInfo::RenderFrameTabInfo(const RenderFrameTabInfo& other) =
+    default;
+
+RenderFrameTabInfo::~RenderFrameTabInfo() {
+}
+
+RenderFrameTabURLMap::RenderFrameTabURLMap() {
+}
+
+RenderFrameTabURLMap::~RenderFrameTabURLMap() {
+}
+
+// static
+uint64_t RenderFrameTabURLMap::GetKey(int render_process_id,
+                                      int render_frame_id) {
+  return (static_cast<uint64_t>(static_cast<uint32_t>(render_process_id))
+          << 32) | static_cast<uint32_t>(render_frame_id);
+}
+
+RenderFrameTabURLMap::Shard& RenderFrameTabURLMap::GetShard(uint64_t key) {
+  // Routing ids grow by one per frame, so frames of one tab land in
+  // different shards.
+  return shards_[((key >> 32) * 31 + key) % kShardCount];
+}
+
+const RenderFrameTabURLMap::Shard& RenderFrameTabURLMap::GetShard(
+    uint64_t key) const {
+  return shards_[((key >> 32) * 31 + key) % kShardCount];
+}
+
+void RenderFrameTabURLMap::Set(int render_process_id,
+                               int render_frame_id,
+                               RenderFrameTabInfo tab_info) {
+  const uint64_t key = GetKey(render_process_id, render_frame_id);
+  Shard& shard = GetShard(key);
+  RenderFrameTabInfo old_info;
+  {
+    base::AutoLock lock(shard.lock);
+    RenderFrameTabInfo& entry = shard.tab_infos[key];
+    std::swap(old_info, entry);
+    std::swap(entry, tab_info);
+  }
+  // |old_info| is freed here, outside of the lock.
+}
+
+void RenderFrameTabURLMap::Remove(int render_process_id,
+                                  int render_frame_id) {
+  const uint64_t key = GetKey(render_process_id, render_frame_id);
+  Shard& shard = GetShard(key);
+  RenderFrameTabInfo old_info;
+  {
+    base::AutoLock lock(shard.lock);
+    auto it = shard.tab_infos.find(key);
+    if (it == shard.tab_infos.end()) {
+      return;
+    }
+    std::swap(old_info, it->second);
+    shard.tab_infos.erase(it);
+  }
+}
+
+GURL RenderFrameTabURLMap::Get(int render_process_id,
+                               int render_frame_id) const {
+  const uint64_t key = GetKey(render_process_id, render_frame_id);
+  const Shard& shard = GetShard(key);
+  base::AutoLock lock(shard.lock);
+  auto it = shard.tab_infos.find(key);
+  if (it == shard.tab_infos.end()) {
+    return GURL();
+  }
+  return it->second.tab_url;
+}
+
+bool RenderFrameTabURLMap::GetTabInfo(int render_process_id,
+                                      int render_frame_id,
+                                      RenderFrameTabInfo* tab_info) const {
+  const uint64_t key = GetKey(render_process_id, render_frame_id);
+  const Shard& shard = GetShard(key);
+  base::AutoLock lock(shard.lock);
+  auto it = shard.tab_infos.find(key);
+  if (it == shard.tab_infos.end()) {
+    return false;
+  }
+  *tab_info = it->second;
+  return true;
+}
+
+size_t RenderFrameTabURLMap::size() const {
+  size_t size = 0;
+  for (const Shard& shard : shards_) {
+    base::AutoLock lock(shard.lock);
+    size += shard.tab_infos.size();
+  }
+  return size;
+}
+
+}  // namespace brave_shields
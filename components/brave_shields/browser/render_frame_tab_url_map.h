@@ -0,0 +1,75 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_RENDER_FRAME_TAB_URL_MAP_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_RENDER_FRAME_TAB_URL_MAP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <unordered_map>
+
+#include "base/macros.h"
+#include "base/synchronization/lock.h"
+#include "url/gurl.h"
+
+namespace brave_shields {
+
+// What the IO thread knows about the tab a render frame belongs to.
+struct RenderFrameTabInfo {
+  RenderFrameTabInfo();
+  RenderFrameTabInfo(const RenderFrameTabInfo& other);
+  ~RenderFrameTabInfo();
+
+  // Identifies the tab: the FrameTreeNode id of its main frame.
+  int tab_frame_tree_node_id;
+  // The main frame navigation which put the frame's document in the tab, or
+  // 0 if the tab had not navigated yet.
+  int64_t navigation_id;
+  GURL tab_url;
+};
+
+// The URL of the tab each render frame belongs to, written on the UI thread
+// as frames come and go and read on the IO thread for every request and
+// cookie access. Frames are spread over independently locked shards, so a
+// lookup rarely waits for frame churn in other tabs, and neither side holds
+// a lock for more than one hash table operation.
+class RenderFrameTabURLMap {
+ public:
+  RenderFrameTabURLMap();
+  ~RenderFrameTabURLMap();
+
+  void Set(int render_process_id,
+           int render_frame_id,
+           RenderFrameTabInfo tab_info);
+  void Remove(int render_process_id, int render_frame_id);
+  // Returns an empty GURL if the frame is not known.
+  GURL Get(int render_process_id, int render_frame_id) const;
+  // Returns false if the frame is not known.
+  bool GetTabInfo(int render_process_id,
+                  int render_frame_id,
+                  RenderFrameTabInfo* tab_info) const;
+
+  size_t size() const;
+
+ private:
+  static const size_t kShardCount = 16;
+
+  struct Shard {
+    mutable base::Lock lock;
+    std::unordered_map<uint64_t, RenderFrameTabInfo> tab_infos;
+  };
+
+  static uint64_t GetKey(int render_process_id, int render_frame_id);
+  Shard& GetShard(uint64_t key);
+  const Shard& GetShard(uint64_t key) const;
+
+  Shard shards_[kShardCount];
+
+  DISALLOW_COPY_AND_ASSIGN(RenderFrameTabURLMap);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_RENDER_FRAME_TAB_URL_MAP_H_
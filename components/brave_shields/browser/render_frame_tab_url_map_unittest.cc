@@ -0,0 +1,76 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/render_frame_tab_url_map.h"
+
+#include <string>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+using brave_shields::RenderFrameTabInfo;
+using brave_shields::RenderFrameTabURLMap;
+
+namespace {
+
+RenderFrameTabInfo MakeTabInfo(const std::string& tab_url) {
+  RenderFrameTabInfo tab_info;
+  tab_info.tab_url = GURL(tab_url);
+  return tab_info;
+}
+
+}  // namespace
+
+TEST(RenderFrameTabURLMapTest, UnknownFrame) {
+  RenderFrameTabURLMap map;
+  EXPECT_TRUE(map.Get(1, 2).is_empty());
+  map.Remove(1, 2);
+  EXPECT_EQ(0u, map.size());
+}
+
+TEST(RenderFrameTabURLMapTest, SetReplacesAndRemoves) {
+  RenderFrameTabURLMap map;
+  map.Set(1, 2, MakeTabInfo("https://a.com/"));
+  map.Set(2, 1, MakeTabInfo("https://b.com/"));
+  EXPECT_EQ(GURL("https://a.com/"), map.Get(1, 2));
+  EXPECT_EQ(GURL("https://b.com/"), map.Get(2, 1));
+  EXPECT_EQ(2u, map.size());
+
+  map.Set(1, 2, MakeTabInfo("https://c.com/"));
+  EXPECT_EQ(GURL("https://c.com/"), map.Get(1, 2));
+  EXPECT_EQ(2u, map.size());
+
+  map.Remove(1, 2);
+  EXPECT_TRUE(map.Get(1, 2).is_empty());
+  EXPECT_EQ(GURL("https://b.com/"), map.Get(2, 1));
+  EXPECT_EQ(1u, map.size());
+}
+
+TEST(RenderFrameTabURLMapTest, ManyFrames) {
+  RenderFrameTabURLMap map;
+  for (int frame = 0; frame < 100; frame++) {
+    map.Set(3, frame, MakeTabInfo("https://a.com/"));
+  }
+  map.Set(-1, -1, MakeTabInfo("https://b.com/"));
+  EXPECT_EQ(101u, map.size());
+  EXPECT_EQ(GURL("https://a.com/"), map.Get(3, 42));
+  EXPECT_EQ(GURL("https://b.com/"), map.Get(-1, -1));
+  EXPECT_TRUE(map.Get(4, 42).is_empty());
+}
+
+TEST(RenderFrameTabURLMapTest, TabInfo) {
+  RenderFrameTabURLMap map;
+  RenderFrameTabInfo tab_info;
+  EXPECT_FALSE(map.GetTabInfo(1, 2, &tab_info));
+
+  tab_info.tab_frame_tree_node_id = 7;
+  tab_info.navigation_id = 3;
+  tab_info.tab_url = GURL("https://a.com/");
+  map.Set(1, 2, tab_info);
+
+  RenderFrameTabInfo result;
+  EXPECT_TRUE(map.GetTabInfo(1, 2, &result));
+  EXPECT_EQ(7, result.tab_frame_tree_node_id);
+  EXPECT_EQ(3, result.navigation_id);
+  EXPECT_EQ(GURL("https://a.com/"), result.tab_url);
+}
@@ -0,0 +1,126 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/renderer_content_setting_rules_cache.h"
+
+#include <set>
+
+#include "base/lazy_instance.h"
+#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
+#include "chrome/browser/profiles/profile.h"
+#include "chrome/common/renderer_configuration.mojom.h"
+#include "components/content_settings/core/browser/host_content_settings_map.h"
+#include "components/content_settings/core/common/content_settings_utils.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/render_process_host.h"
+#include "content/public/browser/web_contents.h"
+#include "ipc/ipc_channel_proxy.h"
+
+namespace {
+
+base::LazyInstance<brave_shields::RendererContentSettingRulesCache>::Leaky
+    g_renderer_content_setting_rules_cache = LAZY_INSTANCE_INITIALIZER;
+
+bool RulesEqual(const ContentSettingsForOneType& a,
+                const ContentSettingsForOneType& b) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.size(); i++) {
+    if (a[i].primary_pattern != b[i].primary_pattern ||
+        a[i].secondary_pattern != b[i].secondary_pattern ||
+        a[i].setting_value != b[i].setting_value ||
+        a[i].source != b[i].source ||
+        a[i].incognito != b[i].incognito) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool RulesEqual(const RendererContentSettingRules& a,
+                const RendererContentSettingRules& b) {
+  return RulesEqual(a.image_rules, b.image_rules) &&
+      RulesEqual(a.script_rules, b.script_rules) &&
+      RulesEqual(a.autoplay_rules, b.autoplay_rules) &&
+      RulesEqual(a.client_hints_rules, b.client_hints_rules) &&
+      RulesEqual(a.popup_redirect_rules, b.popup_redirect_rules) &&
+      RulesEqual(a.fingerprinting_rules, b.fingerprinting_rules) &&
+      RulesEqual(a.brave_shields_rules, b.brave_shields_rules);
+}
+
+}  // namespace
+
+namespace brave_shields {
+
+RendererContentSettingRulesCache::RendererContentSettingRulesCache() {
+}
+
+RendererContentSettingRulesCache::~RendererContentSettingRulesCache() {
+}
+
+// static
+RendererContentSettingRulesCache*
+RendererContentSettingRulesCache::GetInstance() {
+  return g_renderer_content_setting_rules_cache.Pointer();
+}
+
+void RendererContentSettingRulesCache::UpdateRenderProcesses(
+    content::WebContents* web_contents) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  Profile* profile =
+      Profile::FromBrowserContext(web_contents->GetBrowserContext());
+  const HostContentSettingsMap* map =
+      HostContentSettingsMapFactory::GetForProfile(profile);
+  // Gathered once for all frames, every process of a tab shares its profile.
+  RendererContentSettingRules rules;
+  GetRendererContentSettingRules(map, &rules);
+
+  std::set<int> updated_processes;
+  for (content::RenderFrameHost* frame : web_contents->GetAllFrames()) {
+    content::RenderProcessHost* process = frame->GetProcess();
+    if (!updated_processes.insert(process->GetID()).second) {
+      continue;
+    }
+    auto it = sent_rules_.find(process->GetID());
+    if (it != sent_rules_.end() && RulesEqual(it->second, rules)) {
+      continue;
+    }
+    IPC::ChannelProxy* channel = process->GetChannel();
+    // channel might be NULL in tests.
+    if (!channel) {
+      continue;
+    }
+    chrome::mojom::RendererConfigurationAssociatedPtr rc_interface;
+    channel->GetRemoteAssociatedInterface(&rc_interface);
+    rc_interface->SetContentSettingRules(rules);
+    if (it == sent_rules_.end()) {
+      process->AddObserver(this);
+      sent_rules_[process->GetID()] = rules;
+    } else {
+      it->second = rules;
+    }
+  }
+}
+
+void RendererContentSettingRulesCache::RenderProcessExited(
+    content::RenderProcessHost* host,
+    const content::ChildProcessTerminationInfo& info) {
+  // A relaunched process starts without rules.
+  Forget(host);
+}
+
+void RendererContentSettingRulesCache::RenderProcessHostDestroyed(
+    content::RenderProcessHost* host) {
+  Forget(host);
+}
+
+void RendererContentSettingRulesCache::Forget(
+    content::RenderProcessHost* host) {
+  host->RemoveObserver(this);
+  sent_rules_.erase(host->GetID());
+}
+
+}  // namespace brave_shields
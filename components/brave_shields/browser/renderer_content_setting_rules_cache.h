@@ -0,0 +1,53 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_RENDERER_CONTENT_SETTING_RULES_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_RENDERER_CONTENT_SETTING_RULES_CACHE_H_
+
+#include <map>
+
+#include "base/macros.h"
+#include "components/content_settings/core/common/content_settings.h"
+#include "content/public/browser/render_process_host_observer.h"
+
+namespace content {
+class WebContents;
+}
+
+namespace brave_shields {
+
+// Remembers the content setting rules each render process was last sent, so
+// that a rule set is serialized and sent once per process instead of once
+// per frame, and again only when it changes. Must only be used on the UI
+// thread.
+class RendererContentSettingRulesCache
+    : public content::RenderProcessHostObserver {
+ public:
+  RendererContentSettingRulesCache();
+  ~RendererContentSettingRulesCache() override;
+
+  static RendererContentSettingRulesCache* GetInstance();
+
+  // Sends the current rules of |web_contents|' profile to those of its
+  // render processes that do not have them yet.
+  void UpdateRenderProcesses(content::WebContents* web_contents);
+
+ private:
+  // content::RenderProcessHostObserver
+  void RenderProcessExited(
+      content::RenderProcessHost* host,
+      const content::ChildProcessTerminationInfo& info) override;
+  void RenderProcessHostDestroyed(content::RenderProcessHost* host) override;
+
+  void Forget(content::RenderProcessHost* host);
+
+  // By render process id.
+  std::map<int, RendererContentSettingRules> sent_rules_;
+
+  DISALLOW_COPY_AND_ASSIGN(RendererContentSettingRulesCache);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_RENDERER_CONTENT_SETTING_RULES_CACHE_H_
@@ -0,0 +1,116 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHARDED_LRU_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHARDED_LRU_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/containers/mru_cache.h"
+#include "base/logging.h"
+#include "base/macros.h"
+#include "base/synchronization/lock.h"
+
+// Counters describing how well a ShardedLRUCache is doing.
+struct ShardedLRUCacheStats {
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  uint64_t evictions = 0;
+  size_t size = 0;
+  size_t capacity = 0;
+};
+
+// A bounded LRU cache keyed by string which may be used from any thread.
+// Keys are spread over independently locked shards so the IO thread and the
+// blocking pool rarely contend on the same lock. Callers wanting to remember
+// negative results store an empty value for them.
+template <class T> class ShardedLRUCache {
+ public:
+  explicit ShardedLRUCache(size_t capacity = 1000, size_t shard_count = 8)
+      : capacity_(capacity),
+        hits_(0),
+        misses_(0),
+        evictions_(0) {
+    DCHECK_GT(shard_count, 0u);
+    size_t shard_capacity = std::max<size_t>(1, capacity / shard_count);
+    for (size_t i = 0; i < shard_count; i++) {
+      shards_.push_back(std::make_unique<Shard>(shard_capacity));
+    }
+  }
+
+  void Add(const std::string& key, const T& value) {
+    Shard* shard = GetShard(key);
+    base::AutoLock lock(shard->lock);
+    if (shard->data.Peek(key) == shard->data.end() &&
+        shard->data.size() >= shard->data.max_size()) {
+      evictions_++;
+    }
+    shard->data.Put(key, value);
+  }
+
+  // Returns true and fills |value| if |key| is cached, marking it as most
+  // recently used.
+  bool Get(const std::string& key, T* value) {
+    Shard* shard = GetShard(key);
+    base::AutoLock lock(shard->lock);
+    auto it = shard->data.Get(key);
+    if (it == shard->data.end()) {
+      misses_++;
+      return false;
+    }
+    hits_++;
+    *value = it->second;
+    return true;
+  }
+
+  void Clear() {
+    for (const auto& shard : shards_) {
+      base::AutoLock lock(shard->lock);
+      shard->data.Clear();
+    }
+  }
+
+  ShardedLRUCacheStats GetStats() const {
+    ShardedLRUCacheStats stats;
+    stats.hits = hits_;
+    stats.misses = misses_;
+    stats.evictions = evictions_;
+    stats.capacity = capacity_;
+    for (const auto& shard : shards_) {
+      base::AutoLock lock(shard->lock);
+      stats.size += shard->data.size();
+    }
+    return stats;
+  }
+
+ private:
+  struct Shard {
+    explicit Shard(size_t capacity) : data(capacity) {}
+
+    mutable base::Lock lock;
+    base::HashingMRUCache<std::string, T> data;
+  };
+
+  Shard* GetShard(const std::string& key) {
+    return shards_[std::hash<std::string>()(key) % shards_.size()].get();
+  }
+
+  const size_t capacity_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+  std::atomic<uint64_t> hits_;
+  std::atomic<uint64_t> misses_;
+  std::atomic<uint64_t> evictions_;
+
+  DISALLOW_COPY_AND_ASSIGN(ShardedLRUCache);
+};
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHARDED_LRU_CACHE_H_
@@ -0,0 +1,46 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/sharded_lru_cache.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+TEST(ShardedLRUCacheTest, CachesPositiveAndNegativeResults) {
+  ShardedLRUCache<std::string> cache(10, 1);
+  std::string value;
+  EXPECT_FALSE(cache.Get("http://www.digg.com/", &value));
+
+  cache.Add("http://www.digg.com/", "https://www.digg.com/");
+  cache.Add("http://www.brianbondy.com/", "");
+  EXPECT_TRUE(cache.Get("http://www.digg.com/", &value));
+  EXPECT_EQ("https://www.digg.com/", value);
+  EXPECT_TRUE(cache.Get("http://www.brianbondy.com/", &value));
+  EXPECT_TRUE(value.empty());
+
+  ShardedLRUCacheStats stats = cache.GetStats();
+  EXPECT_EQ(2u, stats.hits);
+  EXPECT_EQ(1u, stats.misses);
+  EXPECT_EQ(0u, stats.evictions);
+  EXPECT_EQ(2u, stats.size);
+}
+
+TEST(ShardedLRUCacheTest, EvictsLeastRecentlyUsed) {
+  ShardedLRUCache<std::string> cache(2, 1);
+  std::string value;
+  cache.Add("a", "1");
+  cache.Add("b", "2");
+  // Touch "a" so that "b" is the oldest entry.
+  EXPECT_TRUE(cache.Get("a", &value));
+  cache.Add("c", "3");
+  EXPECT_TRUE(cache.Get("a", &value));
+  EXPECT_FALSE(cache.Get("b", &value));
+  EXPECT_TRUE(cache.Get("c", &value));
+
+  ShardedLRUCacheStats stats = cache.GetStats();
+  EXPECT_EQ(1u, stats.evictions);
+  EXPECT_EQ(2u, stats.size);
+  EXPECT_EQ(2u, stats.capacity);
+
+  cache.Clear();
+  EXPECT_EQ(0u, cache.GetStats().size);
+}
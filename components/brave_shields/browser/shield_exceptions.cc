@@ -0,0 +1,39 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/shield_exceptions.h"
+
+#include "brave/components/brave_shields/browser/site_hacks_rule_table.h"
+#include "brave/components/brave_shields/browser/site_hacks_service.h"
+#include "url/gurl.h"
+
+using brave_shields::SiteHackAction;
+using brave_shields::SiteHacksService;
+
+namespace brave {
+
+bool IsWhitelistedReferrer(const GURL& firstPartyOrigin,
+    const GURL& subresourceUrl) {
+  // Note that there's already an exception for TLD+1, so don't add those to
+  // the rules. Check with the security team before adding exceptions.
+  // The reddit rules only allow reddit -> redditmedia -> embedly -> imgur,
+  // see https://github.com/brave/browser-laptop/issues/5861
+  return SiteHacksService::GetRules()->MatchesWhitelist(
+      SiteHackAction::kReferrerWhitelist, firstPartyOrigin, subresourceUrl);
+}
+
+bool IsWhitelistedCookieExeption(const GURL& firstPartyOrigin,
+    const GURL& subresourceUrl) {
+  // Note that there's already an exception for TLD+1, so don't add those to
+  // the rules. Check with the security team before adding exceptions.
+  return SiteHacksService::GetRules()->MatchesWhitelist(
+      SiteHackAction::kCookieWhitelist, firstPartyOrigin, subresourceUrl);
+}
+
+bool IsWidevineInstallableURL(const GURL& url) {
+  return SiteHacksService::GetRules()->FindRule(
+      url, SiteHackAction::kWidevineInstallable) != nullptr;
+}
+
+}  // namespace brave
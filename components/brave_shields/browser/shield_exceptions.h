@@ -2,13 +2,14 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELD_EXCEPTIONS_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELD_EXCEPTIONS_H_
+
 class GURL;
 
 namespace brave {
 
-bool IsEmptyDataURLRedirect(const GURL& gurl);
-bool IsUAWhitelisted(const GURL& gurl);
-bool IsBlockedResource(const GURL& gurl);
+// The exceptions come from the site hacks rules, see SiteHacksService.
 bool IsWhitelistedCookieExeption(const GURL& firstPartyOrigin,
                                  const GURL& subresourceUrl);
 bool IsWhitelistedReferrer(const GURL& firstPartyOrigin,
@@ -16,3 +17,5 @@ bool IsWhitelistedReferrer(const GURL& firstPartyOrigin,
 bool IsWidevineInstallableURL(const GURL& url);
 
 }  // namespace brave
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELD_EXCEPTIONS_H_
@@ -2,7 +2,7 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
-#include "brave/common/shield_exceptions.h"
+#include "brave/components/brave_shields/browser/shield_exceptions.h"
 
 
 #include "chrome/test/base/chrome_render_view_host_test_harness.h"
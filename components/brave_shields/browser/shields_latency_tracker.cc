@@ -0,0 +1,190 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/shields_latency_tracker.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/lazy_instance.h"
+#include "base/metrics/histogram.h"
+#include "base/strings/strcat.h"
+
+namespace {
+
+// Enough for stable percentiles without the buffers growing large.
+const size_t kMaxSamplesPerStage = 1000;
+const size_t kMaxSlowRequests = 20;
+
+const char* const kStageNames[] = {
+  "OnBeforeURLRequest",
+  "OnBeforeStartTransaction",
+  "HTTPSELookup",
+  "HTTPSEBlockingPoolHop",
+  "AdBlockMatch",
+  "TrackingProtectionMatch",
+};
+
+static_assert(arraysize(kStageNames) ==
+                  brave_shields::kShieldsLatencyStageCount,
+              "Every latency stage needs a name");
+
+base::LazyInstance<brave_shields::ShieldsLatencyTracker>::Leaky
+    g_shields_latency_tracker = LAZY_INSTANCE_INITIALIZER;
+
+// Returns the value at |percentile| of |samples|, which it reorders.
+base::TimeDelta GetPercentile(std::vector<base::TimeDelta>* samples,
+                              size_t percentile) {
+  if (samples->empty()) {
+    return base::TimeDelta();
+  }
+  auto nth = samples->begin() + (samples->size() - 1) * percentile / 100;
+  std::nth_element(samples->begin(), nth, samples->end());
+  return *nth;
+}
+
+// Query and fragment are left out, they are not needed to tell which rule
+// or list was slow.
+std::string GetURLForDisplay(const GURL& url) {
+  GURL::Replacements replacements;
+  replacements.ClearQuery();
+  replacements.ClearRef();
+  return url.ReplaceComponents(replacements).possibly_invalid_spec();
+}
+
+}  // namespace
+
+namespace brave_shields {
+
+ShieldsLatencyTracker::Stage::Stage() {
+}
+
+ShieldsLatencyTracker::Stage::~Stage() {
+}
+
+ShieldsLatencyTracker::ShieldsLatencyTracker() {
+  for (size_t i = 0; i < kShieldsLatencyStageCount; i++) {
+    stages_[i].samples.reserve(kMaxSamplesPerStage);
+    // Looked up once so that recording a sample does not go through the
+    // StatisticsRecorder.
+    stages_[i].latency_histogram = base::Histogram::FactoryGet(
+        base::StrCat({"Brave.Shields.Latency.", kStageNames[i]}),
+        1, base::Time::kMicrosecondsPerSecond, 50,
+        base::HistogramBase::kUmaTargetedHistogramFlag);
+    stages_[i].cache_hit_histogram = base::BooleanHistogram::FactoryGet(
+        base::StrCat({"Brave.Shields.CacheHit.", kStageNames[i]}),
+        base::HistogramBase::kUmaTargetedHistogramFlag);
+  }
+}
+
+ShieldsLatencyTracker::~ShieldsLatencyTracker() {
+}
+
+// static
+ShieldsLatencyTracker* ShieldsLatencyTracker::GetInstance() {
+  return g_shields_latency_tracker.Pointer();
+}
+
+// static
+const char* ShieldsLatencyTracker::GetStageName(ShieldsLatencyStage stage) {
+  return kStageNames[static_cast<size_t>(stage)];
+}
+
+void ShieldsLatencyTracker::Record(ShieldsLatencyStage stage,
+                                   base::TimeDelta duration,
+                                   const GURL& url,
+                                   bool is_off_the_record) {
+  Stage& data = stages_[static_cast<size_t>(stage)];
+  data.latency_histogram->Add(
+      static_cast<base::HistogramBase::Sample>(duration.InMicroseconds()));
+
+  base::AutoLock lock(lock_);
+  if (data.samples.size() < kMaxSamplesPerStage) {
+    data.samples.push_back(duration);
+  } else {
+    data.samples[data.next_sample] = duration;
+  }
+  data.next_sample = (data.next_sample + 1) % kMaxSamplesPerStage;
+
+  if (slowest_requests_.size() == kMaxSlowRequests &&
+      duration <= slowest_requests_.back().duration) {
+    return;
+  }
+  SlowRequest slow_request = {
+    stage, is_off_the_record ? std::string() : GetURLForDisplay(url), duration
+  };
+  auto it = std::upper_bound(slowest_requests_.begin(),
+      slowest_requests_.end(), slow_request,
+      [](const SlowRequest& a, const SlowRequest& b) {
+        return a.duration > b.duration;
+      });
+  slowest_requests_.insert(it, std::move(slow_request));
+  if (slowest_requests_.size() > kMaxSlowRequests) {
+    slowest_requests_.pop_back();
+  }
+}
+
+void ShieldsLatencyTracker::RecordCacheLookup(ShieldsLatencyStage stage,
+                                              bool hit) {
+  Stage& data = stages_[static_cast<size_t>(stage)];
+  data.cache_hit_histogram->AddBoolean(hit);
+
+  base::AutoLock lock(lock_);
+  if (hit) {
+    data.cache_hits++;
+  } else {
+    data.cache_misses++;
+  }
+}
+
+std::vector<ShieldsLatencyTracker::StageSummary>
+ShieldsLatencyTracker::GetStageSummaries() const {
+  std::vector<StageSummary> summaries;
+  for (size_t i = 0; i < kShieldsLatencyStageCount; i++) {
+    std::vector<base::TimeDelta> samples;
+    StageSummary summary;
+    summary.name = kStageNames[i];
+    {
+      base::AutoLock lock(lock_);
+      samples = stages_[i].samples;
+      summary.cache_hits = stages_[i].cache_hits;
+      summary.cache_misses = stages_[i].cache_misses;
+    }
+    summary.sample_count = samples.size();
+    summary.p50 = GetPercentile(&samples, 50);
+    summary.p99 = GetPercentile(&samples, 99);
+    if (!samples.empty()) {
+      summary.max = *std::max_element(samples.begin(), samples.end());
+    }
+    summaries.push_back(summary);
+  }
+  return summaries;
+}
+
+std::vector<ShieldsLatencyTracker::SlowRequest>
+ShieldsLatencyTracker::GetSlowestRequests() const {
+  base::AutoLock lock(lock_);
+  return slowest_requests_;
+}
+
+ScopedShieldsLatencyTimer::ScopedShieldsLatencyTimer(
+    ShieldsLatencyStage stage, const GURL& url, bool is_off_the_record)
+    : stage_(stage),
+      url_(url),
+      is_off_the_record_(is_off_the_record),
+      start_(base::TimeTicks::Now()) {
+  TRACE_EVENT_BEGIN0(BRAVE_SHIELDS_TRACE_CATEGORY,
+                     ShieldsLatencyTracker::GetStageName(stage_));
+}
+
+ScopedShieldsLatencyTimer::~ScopedShieldsLatencyTimer() {
+  TRACE_EVENT_END1(BRAVE_SHIELDS_TRACE_CATEGORY,
+                   ShieldsLatencyTracker::GetStageName(stage_),
+                   "url", is_off_the_record_ ? std::string() :
+                                               url_.possibly_invalid_spec());
+  ShieldsLatencyTracker::GetInstance()->Record(
+      stage_, base::TimeTicks::Now() - start_, url_, is_off_the_record_);
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,127 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_LATENCY_TRACKER_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_LATENCY_TRACKER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
+#include "base/trace_event/trace_event.h"
+#include "url/gurl.h"
+
+namespace base {
+class HistogramBase;
+}
+
+// Trace category of the shields request path. Enable it in chrome://tracing.
+#define BRAVE_SHIELDS_TRACE_CATEGORY TRACE_DISABLED_BY_DEFAULT("brave.shields")
+
+namespace brave_shields {
+
+enum class ShieldsLatencyStage {
+  // The whole Brave network delegate chain, including time spent waiting on
+  // asynchronous handlers.
+  kOnBeforeURLRequest = 0,
+  kOnBeforeStartTransaction,
+  // HTTPS Everywhere lookups made on the IO thread.
+  kHTTPSELookup,
+  // From posting an HTTPS Everywhere lookup to the blocking pool until the
+  // IO thread gets the reply.
+  kHTTPSEBlockingPoolHop,
+  kAdBlockMatch,
+  kTrackingProtectionMatch,
+};
+
+const size_t kShieldsLatencyStageCount = 6;
+
+// Collects per stage latencies of the shields request path. Each sample is
+// reported to UMA as Brave.Shields.Latency.<Stage>, in microseconds, and the
+// most recent ones are kept for chrome://shields-internals along with the
+// slowest requests seen. The tracker is shared by every profile, so the URLs
+// of off the record requests are never kept. May be used from any thread.
+class ShieldsLatencyTracker {
+ public:
+  struct StageSummary {
+    const char* name = nullptr;
+    size_t sample_count = 0;
+    base::TimeDelta p50;
+    base::TimeDelta p99;
+    base::TimeDelta max;
+    uint64_t cache_hits = 0;
+    uint64_t cache_misses = 0;
+  };
+
+  struct SlowRequest {
+    ShieldsLatencyStage stage;
+    // Empty for off the record requests.
+    std::string url;
+    base::TimeDelta duration;
+  };
+
+  ShieldsLatencyTracker();
+  ~ShieldsLatencyTracker();
+
+  static ShieldsLatencyTracker* GetInstance();
+  static const char* GetStageName(ShieldsLatencyStage stage);
+
+  void Record(ShieldsLatencyStage stage,
+              base::TimeDelta duration,
+              const GURL& url,
+              bool is_off_the_record);
+  // Records whether |stage| was answered from its cache.
+  void RecordCacheLookup(ShieldsLatencyStage stage, bool hit);
+
+  std::vector<StageSummary> GetStageSummaries() const;
+  // Slowest first.
+  std::vector<SlowRequest> GetSlowestRequests() const;
+
+ private:
+  struct Stage {
+    Stage();
+    ~Stage();
+
+    // Ring buffer of the most recent samples.
+    std::vector<base::TimeDelta> samples;
+    size_t next_sample = 0;
+    uint64_t cache_hits = 0;
+    uint64_t cache_misses = 0;
+    base::HistogramBase* latency_histogram = nullptr;
+    base::HistogramBase* cache_hit_histogram = nullptr;
+  };
+
+  mutable base::Lock lock_;
+  Stage stages_[kShieldsLatencyStageCount];
+  std::vector<SlowRequest> slowest_requests_;
+
+  DISALLOW_COPY_AND_ASSIGN(ShieldsLatencyTracker);
+};
+
+// Records the time until it goes out of scope for |stage|, and brackets it
+// with a trace event.
+class ScopedShieldsLatencyTimer {
+ public:
+  ScopedShieldsLatencyTimer(ShieldsLatencyStage stage,
+                            const GURL& url,
+                            bool is_off_the_record);
+  ~ScopedShieldsLatencyTimer();
+
+ private:
+  const ShieldsLatencyStage stage_;
+  const GURL& url_;
+  const bool is_off_the_record_;
+  const base::TimeTicks start_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedShieldsLatencyTimer);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_LATENCY_TRACKER_H_
@@ -0,0 +1,97 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/shields_latency_tracker.h"
+
+#include <string>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+using brave_shields::ShieldsLatencyStage;
+using brave_shields::ShieldsLatencyTracker;
+
+namespace {
+
+const ShieldsLatencyTracker::StageSummary& GetSummary(
+    const std::vector<ShieldsLatencyTracker::StageSummary>& summaries,
+    ShieldsLatencyStage stage) {
+  return summaries[static_cast<size_t>(stage)];
+}
+
+TEST(ShieldsLatencyTrackerTest, ComputesPercentiles) {
+  ShieldsLatencyTracker tracker;
+  const GURL url("https://brave.com/");
+  for (int i = 1; i <= 100; i++) {
+    tracker.Record(ShieldsLatencyStage::kAdBlockMatch,
+                   base::TimeDelta::FromMicroseconds(i), url, false);
+  }
+
+  auto summaries = tracker.GetStageSummaries();
+  const auto& ad_block =
+      GetSummary(summaries, ShieldsLatencyStage::kAdBlockMatch);
+  EXPECT_EQ(100u, ad_block.sample_count);
+  EXPECT_EQ(base::TimeDelta::FromMicroseconds(50), ad_block.p50);
+  EXPECT_EQ(base::TimeDelta::FromMicroseconds(99), ad_block.p99);
+  EXPECT_EQ(base::TimeDelta::FromMicroseconds(100), ad_block.max);
+
+  const auto& tracking_protection =
+      GetSummary(summaries, ShieldsLatencyStage::kTrackingProtectionMatch);
+  EXPECT_EQ(0u, tracking_protection.sample_count);
+  EXPECT_EQ(base::TimeDelta(), tracking_protection.p99);
+}
+
+TEST(ShieldsLatencyTrackerTest, KeepsSlowestRequests) {
+  ShieldsLatencyTracker tracker;
+  for (int i = 1; i <= 50; i++) {
+    tracker.Record(ShieldsLatencyStage::kHTTPSELookup,
+                   base::TimeDelta::FromMilliseconds(i),
+                   GURL("https://brave.com/" + std::to_string(i) + "?q=1"),
+                   false);
+  }
+
+  auto slowest = tracker.GetSlowestRequests();
+  ASSERT_EQ(20u, slowest.size());
+  EXPECT_EQ(base::TimeDelta::FromMilliseconds(50), slowest.front().duration);
+  EXPECT_EQ("https://brave.com/50", slowest.front().url);
+  EXPECT_EQ(base::TimeDelta::FromMilliseconds(31), slowest.back().duration);
+}
+
+TEST(ShieldsLatencyTrackerTest, DropsOffTheRecordURLs) {
+  ShieldsLatencyTracker tracker;
+  tracker.Record(ShieldsLatencyStage::kAdBlockMatch,
+                 base::TimeDelta::FromMilliseconds(2),
+                 GURL("https://brave.com/private"), true);
+  tracker.Record(ShieldsLatencyStage::kAdBlockMatch,
+                 base::TimeDelta::FromMilliseconds(1),
+                 GURL("https://brave.com/public"), false);
+
+  auto slowest = tracker.GetSlowestRequests();
+  ASSERT_EQ(2u, slowest.size());
+  EXPECT_EQ(ShieldsLatencyStage::kAdBlockMatch, slowest[0].stage);
+  EXPECT_EQ(base::TimeDelta::FromMilliseconds(2), slowest[0].duration);
+  EXPECT_TRUE(slowest[0].url.empty());
+  EXPECT_EQ("https://brave.com/public", slowest[1].url);
+
+  auto summaries = tracker.GetStageSummaries();
+  EXPECT_EQ(2u,
+            GetSummary(summaries, ShieldsLatencyStage::kAdBlockMatch)
+                .sample_count);
+}
+
+TEST(ShieldsLatencyTrackerTest, CountsCacheLookups) {
+  ShieldsLatencyTracker tracker;
+  tracker.RecordCacheLookup(ShieldsLatencyStage::kHTTPSELookup, true);
+  tracker.RecordCacheLookup(ShieldsLatencyStage::kHTTPSELookup, true);
+  tracker.RecordCacheLookup(ShieldsLatencyStage::kHTTPSELookup, false);
+
+  auto summaries = tracker.GetStageSummaries();
+  const auto& httpse =
+      GetSummary(summaries, ShieldsLatencyStage::kHTTPSELookup);
+  EXPECT_EQ(2u, httpse.cache_hits);
+  EXPECT_EQ(1u, httpse.cache_misses);
+}
+
+}  // namespace
@@ -0,0 +1,366 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/site_hacks_rule_table.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "base/json/json_reader.h"
+#include "base/logging.h"
+#include "base/values.h"
+#include "url/gurl.h"
+
+namespace {
+
+#define SITE_HACKS_INDEX_MAGIC    0x4b434148  // "HACK"
+#define SITE_HACKS_INDEX_VERSION  1
+
+struct ActionName {
+  const char* name;
+  brave_shields::SiteHackAction action;
+};
+
+const ActionName kActionNames[] = {
+  { "empty-data-redirect", brave_shields::SiteHackAction::kEmptyDataRedirect },
+  { "block", brave_shields::SiteHackAction::kBlock },
+  { "polyfill", brave_shields::SiteHackAction::kPolyfill },
+  { "cookie-override", brave_shields::SiteHackAction::kCookieOverride },
+  { "block-from-referrer",
+    brave_shields::SiteHackAction::kBlockFromReferrer },
+  { "user-agent-whitelist",
+    brave_shields::SiteHackAction::kUserAgentWhitelist },
+  { "geolocation-redirect",
+    brave_shields::SiteHackAction::kGeolocationRedirect },
+  { "safebrowsing-redirect",
+    brave_shields::SiteHackAction::kSafeBrowsingRedirect },
+  { "referrer-whitelist", brave_shields::SiteHackAction::kReferrerWhitelist },
+  { "cookie-whitelist", brave_shields::SiteHackAction::kCookieWhitelist },
+  { "widevine-installable",
+    brave_shields::SiteHackAction::kWidevineInstallable },
+};
+
+// The binary index is a header, one record per rule and a string pool.
+struct Header {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t count;
+  uint32_t reserved;
+};
+
+struct StringRef {
+  uint32_t offset;
+  uint32_t length;
+};
+
+struct RuleRecord {
+  uint32_t action;
+  StringRef pattern;
+  StringRef referrer;
+  StringRef first_party;
+  StringRef value;
+};
+
+// A rule as stored in either format, before its patterns are parsed.
+struct RuleSpec {
+  brave_shields::SiteHackAction action;
+  std::string pattern;
+  std::string referrer;
+  std::string first_party;
+  std::string value;
+};
+
+bool GetActionFromName(const std::string& name,
+                       brave_shields::SiteHackAction* action) {
+  for (const ActionName& action_name : kActionNames) {
+    if (name == action_name.name) {
+      *action = action_name.action;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Actions from a newer index are not known to this version.
+bool GetActionFromValue(uint32_t value,
+                        brave_shields::SiteHackAction* action) {
+  for (const ActionName& action_name : kActionNames) {
+    if (value == static_cast<uint32_t>(action_name.action)) {
+      *action = action_name.action;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool IsWhitelist(brave_shields::SiteHackAction action) {
+  return action == brave_shields::SiteHackAction::kReferrerWhitelist ||
+      action == brave_shields::SiteHackAction::kCookieWhitelist;
+}
+
+bool ParsePattern(const std::string& spec, URLPattern* pattern) {
+  *pattern = URLPattern(URLPattern::SCHEME_ALL);
+  return pattern->Parse(spec) == URLPattern::ParseResult::kSuccess;
+}
+
+bool BuildRule(const RuleSpec& spec, brave_shields::SiteHackRule* rule) {
+  rule->action = spec.action;
+  if (!ParsePattern(spec.pattern, &rule->pattern)) {
+    LOG(WARNING) << "Invalid site hack pattern " << spec.pattern;
+    return false;
+  }
+  if (spec.action == brave_shields::SiteHackAction::kBlockFromReferrer &&
+      !ParsePattern(spec.referrer, &rule->referrer_pattern)) {
+    return false;
+  }
+  if (IsWhitelist(spec.action) &&
+      !ParsePattern(spec.first_party.empty() ?
+                        URLPattern::kAllUrlsPattern : spec.first_party,
+                    &rule->first_party_pattern)) {
+    return false;
+  }
+  rule->value = spec.value;
+  return true;
+}
+
+StringRef AppendString(const std::string& str,
+                       uint32_t pool_start,
+                       std::string* pool) {
+  StringRef ref;
+  ref.offset = pool_start + pool->size();
+  ref.length = str.size();
+  pool->append(str);
+  return ref;
+}
+
+bool GetString(base::StringPiece data, const StringRef& ref,
+               std::string* str) {
+  if (ref.offset > data.size() || ref.length > data.size() - ref.offset) {
+    return false;
+  }
+  data.substr(ref.offset, ref.length).CopyToString(str);
+  return true;
+}
+
+}  // namespace
+
+namespace brave_shields {
+
+SiteHackRule::SiteHackRule() : action(SiteHackAction::kBlock) {
+}
+
+SiteHackRule::SiteHackRule(SiteHackRule&& other) = default;
+
+SiteHackRule::~SiteHackRule() {
+}
+
+SiteHacksRuleTable::SiteHacksRuleTable() : has_subdomain_rules_(false) {
+}
+
+SiteHacksRuleTable::~SiteHacksRuleTable() {
+}
+
+// static
+scoped_refptr<SiteHacksRuleTable> SiteHacksRuleTable::Parse(
+    base::StringPiece json) {
+  std::unique_ptr<base::Value> json_object = base::JSONReader::Read(json);
+  if (!json_object || !json_object->is_list()) {
+    return nullptr;
+  }
+
+  scoped_refptr<SiteHacksRuleTable> table(new SiteHacksRuleTable());
+  for (const base::Value& value : json_object->GetList()) {
+    const base::DictionaryValue* dictionary = nullptr;
+    if (!value.GetAsDictionary(&dictionary)) {
+      continue;
+    }
+    std::string action;
+    std::string pattern;
+    if (!dictionary->GetString("action", &action) ||
+        !dictionary->GetString("pattern", &pattern)) {
+      continue;
+    }
+
+    RuleSpec spec;
+    if (!GetActionFromName(action, &spec.action)) {
+      // Left for newer versions of the browser.
+      continue;
+    }
+    spec.pattern = pattern;
+    dictionary->GetString("referrer", &spec.referrer);
+    dictionary->GetString("first-party", &spec.first_party);
+    dictionary->GetString("value", &spec.value);
+    SiteHackRule rule;
+    if (BuildRule(spec, &rule)) {
+      table->rules_.push_back(std::move(rule));
+    }
+  }
+  table->BuildIndex();
+  return table;
+}
+
+// static
+scoped_refptr<SiteHacksRuleTable> SiteHacksRuleTable::ParseIndex(
+    base::StringPiece data) {
+  if (data.size() < sizeof(Header)) {
+    return nullptr;
+  }
+  Header header;
+  memcpy(&header, data.data(), sizeof(header));
+  if (header.magic != SITE_HACKS_INDEX_MAGIC ||
+      header.version != SITE_HACKS_INDEX_VERSION ||
+      header.count > (data.size() - sizeof(Header)) / sizeof(RuleRecord)) {
+    return nullptr;
+  }
+
+  scoped_refptr<SiteHacksRuleTable> table(new SiteHacksRuleTable());
+  table->rules_.reserve(header.count);
+  for (uint32_t i = 0; i < header.count; ++i) {
+    RuleRecord record;
+    memcpy(&record, data.data() + sizeof(Header) + i * sizeof(RuleRecord),
+           sizeof(record));
+    RuleSpec spec;
+    if (!GetString(data, record.pattern, &spec.pattern) ||
+        !GetString(data, record.referrer, &spec.referrer) ||
+        !GetString(data, record.first_party, &spec.first_party) ||
+        !GetString(data, record.value, &spec.value)) {
+      return nullptr;
+    }
+    if (!GetActionFromValue(record.action, &spec.action)) {
+      continue;
+    }
+    SiteHackRule rule;
+    if (BuildRule(spec, &rule)) {
+      table->rules_.push_back(std::move(rule));
+    }
+  }
+  table->BuildIndex();
+  return table;
+}
+
+void SiteHacksRuleTable::Serialize(std::string* output) const {
+  Header header;
+  header.magic = SITE_HACKS_INDEX_MAGIC;
+  header.version = SITE_HACKS_INDEX_VERSION;
+  header.count = rules_.size();
+  header.reserved = 0;
+
+  std::vector<RuleRecord> records;
+  records.reserve(rules_.size());
+  std::string pool;
+  const uint32_t pool_start =
+      sizeof(Header) + sizeof(RuleRecord) * rules_.size();
+  for (const SiteHackRule& rule : rules_) {
+    RuleRecord record;
+    record.action = static_cast<uint32_t>(rule.action);
+    record.pattern =
+        AppendString(rule.pattern.GetAsString(), pool_start, &pool);
+    record.referrer = AppendString(
+        rule.action == SiteHackAction::kBlockFromReferrer ?
+            rule.referrer_pattern.GetAsString() : std::string(),
+        pool_start, &pool);
+    record.first_party = AppendString(
+        IsWhitelist(rule.action) ?
+            rule.first_party_pattern.GetAsString() : std::string(),
+        pool_start, &pool);
+    record.value = AppendString(rule.value, pool_start, &pool);
+    records.push_back(record);
+  }
+
+  output->clear();
+  output->reserve(pool_start + pool.size());
+  output->append(reinterpret_cast<const char*>(&header), sizeof(header));
+  if (!records.empty()) {
+    output->append(reinterpret_cast<const char*>(&records.front()),
+                   sizeof(RuleRecord) * records.size());
+  }
+  output->append(pool);
+}
+
+void SiteHacksRuleTable::BuildIndex() {
+  // |rules_| must not change after this, the keys point into it.
+  for (size_t i = 0; i < rules_.size(); i++) {
+    const URLPattern& pattern = rules_[i].pattern;
+    if (pattern.host().empty()) {
+      any_host_rules_.push_back(i);
+      continue;
+    }
+    rules_by_host_[pattern.host()].push_back(i);
+    if (pattern.match_subdomains()) {
+      has_subdomain_rules_ = true;
+    }
+  }
+}
+
+template <typename Visitor>
+void SiteHacksRuleTable::VisitCandidates(const GURL& url,
+                                         Visitor visit) const {
+  base::StringPiece host = url.host_piece();
+  while (!host.empty()) {
+    auto it = rules_by_host_.find(host);
+    if (it != rules_by_host_.end()) {
+      for (size_t index : it->second) {
+        visit(index);
+      }
+    }
+    if (!has_subdomain_rules_) {
+      break;
+    }
+    size_t dot = host.find('.');
+    if (dot == base::StringPiece::npos) {
+      break;
+    }
+    host.remove_prefix(dot + 1);
+  }
+  for (size_t index : any_host_rules_) {
+    visit(index);
+  }
+}
+
+void SiteHacksRuleTable::FindRules(
+    const GURL& url, std::vector<const SiteHackRule*>* rules) const {
+  const size_t first_match = rules->size();
+  VisitCandidates(url, [this, &url, rules](size_t index) {
+    if (rules_[index].pattern.MatchesURL(url)) {
+      rules->push_back(&rules_[index]);
+    }
+  });
+  // Candidates come grouped by host, |rules_| has them in table order.
+  std::sort(rules->begin() + first_match, rules->end());
+}
+
+const SiteHackRule* SiteHacksRuleTable::FindRule(const GURL& url,
+    SiteHackAction action) const {
+  const SiteHackRule* first_match = nullptr;
+  VisitCandidates(url, [this, &url, action, &first_match](size_t index) {
+    const SiteHackRule* rule = &rules_[index];
+    if (rule->action == action && (!first_match || rule < first_match) &&
+        rule->pattern.MatchesURL(url)) {
+      first_match = rule;
+    }
+  });
+  return first_match;
+}
+
+bool SiteHacksRuleTable::MatchesWhitelist(SiteHackAction action,
+                                          const GURL& first_party,
+                                          const GURL& url) const {
+  bool matches = false;
+  VisitCandidates(url, [this, &first_party, &url, action,
+                        &matches](size_t index) {
+    const SiteHackRule& rule = rules_[index];
+    if (!matches && rule.action == action &&
+        rule.first_party_pattern.MatchesURL(first_party) &&
+        rule.pattern.MatchesURL(url)) {
+      matches = true;
+    }
+  });
+  return matches;
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,119 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SITE_HACKS_RULE_TABLE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SITE_HACKS_RULE_TABLE_H_
+
+#include <stddef.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/strings/string_piece.h"
+#include "extensions/common/url_pattern.h"
+
+class GURL;
+
+namespace brave_shields {
+
+enum class SiteHackAction {
+  // Redirects the request to an empty data: URL.
+  kEmptyDataRedirect = 0,
+  kBlock,
+  // Redirects the request to the polyfill named by the rule's value.
+  kPolyfill,
+  // Appends the rule's value to the Cookie header.
+  kCookieOverride,
+  // Blocks the request if its referrer matches the rule's referrer pattern.
+  kBlockFromReferrer,
+  // Adds Brave to the User-Agent header.
+  kUserAgentWhitelist,
+  kGeolocationRedirect,
+  kSafeBrowsingRedirect,
+  // Keeps the full referrer for the request when the first party matches.
+  kReferrerWhitelist,
+  // Allows third party cookies for the request when the first party matches.
+  kCookieWhitelist,
+  // Offers to install Widevine on the page.
+  kWidevineInstallable,
+};
+
+struct SiteHackRule {
+  SiteHackRule();
+  SiteHackRule(SiteHackRule&& other);
+  ~SiteHackRule();
+
+  SiteHackAction action;
+  URLPattern pattern;
+  // Only set for kBlockFromReferrer.
+  URLPattern referrer_pattern;
+  // Only set for the whitelists, matches all URLs unless the rule names a
+  // first party.
+  URLPattern first_party_pattern;
+  std::string value;
+};
+
+// All site hacks, static redirects and shield exceptions, parsed once and
+// indexed by the host of their pattern, so that a request for a host without
+// rules costs a hash lookup per host label and no pattern matching.
+// Instances are immutable once created and may be used from any thread.
+//
+// The built-in rules are written in JSON, the site hacks component delivers
+// updates in the binary form written by Serialize().
+class SiteHacksRuleTable
+    : public base::RefCountedThreadSafe<SiteHacksRuleTable> {
+ public:
+  // Returns nullptr if |json| is not a list of rules. Rules with an unknown
+  // action or an invalid pattern are skipped.
+  static scoped_refptr<SiteHacksRuleTable> Parse(base::StringPiece json);
+
+  // Returns nullptr if |data| is not a binary rule index of the current
+  // version. Rules with an unknown action or an invalid pattern are skipped.
+  static scoped_refptr<SiteHacksRuleTable> ParseIndex(base::StringPiece data);
+
+  // Writes the rules in the format read by ParseIndex().
+  void Serialize(std::string* output) const;
+
+  // Appends the rules matching |url| to |rules|, in table order.
+  void FindRules(const GURL& url,
+                 std::vector<const SiteHackRule*>* rules) const;
+  // Returns the first rule for |action| that matches |url|, or nullptr.
+  const SiteHackRule* FindRule(const GURL& url, SiteHackAction action) const;
+  // True if a rule for |action| matches |url| and its first party pattern
+  // matches |first_party|.
+  bool MatchesWhitelist(SiteHackAction action,
+                        const GURL& first_party,
+                        const GURL& url) const;
+
+  size_t size() const { return rules_.size(); }
+
+ private:
+  friend class base::RefCountedThreadSafe<SiteHacksRuleTable>;
+
+  SiteHacksRuleTable();
+  ~SiteHacksRuleTable();
+
+  void BuildIndex();
+  // Calls |visit| with the index of every rule that may match |url|.
+  template <typename Visitor>
+  void VisitCandidates(const GURL& url, Visitor visit) const;
+
+  std::vector<SiteHackRule> rules_;
+  // Keys point into the patterns of |rules_|.
+  std::unordered_map<base::StringPiece, std::vector<size_t>,
+                     base::StringPieceHash> rules_by_host_;
+  // Rules whose pattern matches any host.
+  std::vector<size_t> any_host_rules_;
+  // Without subdomain patterns only the full host has to be looked up.
+  bool has_subdomain_rules_;
+
+  DISALLOW_COPY_AND_ASSIGN(SiteHacksRuleTable);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SITE_HACKS_RULE_TABLE_H_
@@ -0,0 +1,119 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/site_hacks_rule_table.h"
+
+#include <string>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+using brave_shields::SiteHackAction;
+using brave_shields::SiteHackRule;
+using brave_shields::SiteHacksRuleTable;
+
+TEST(SiteHacksRuleTableTest, InvalidJSON) {
+  EXPECT_FALSE(SiteHacksRuleTable::Parse("not json"));
+  EXPECT_FALSE(SiteHacksRuleTable::Parse("{\"rules\": []}"));
+}
+
+TEST(SiteHacksRuleTableTest, SkipsUnknownAndInvalidRules) {
+  scoped_refptr<SiteHacksRuleTable> table = SiteHacksRuleTable::Parse(
+      "[{\"action\": \"block\", \"pattern\": \"https://a.com/*\"},"
+      "{\"action\": \"teleport\", \"pattern\": \"https://b.com/*\"},"
+      "{\"action\": \"block\", \"pattern\": \"not a pattern\"},"
+      "{\"action\": \"block-from-referrer\","
+      " \"pattern\": \"https://c.com/*\"}]");
+  ASSERT_TRUE(table);
+  EXPECT_EQ(1u, table->size());
+}
+
+TEST(SiteHacksRuleTableTest, MatchesHostsAndSubdomains) {
+  scoped_refptr<SiteHacksRuleTable> table = SiteHacksRuleTable::Parse(
+      "[{\"action\": \"block\", \"pattern\": \"https://www.a.com/x.js\"},"
+      "{\"action\": \"user-agent-whitelist\","
+      " \"pattern\": \"https://*.b.com/*\"}]");
+  ASSERT_TRUE(table);
+  EXPECT_TRUE(table->FindRule(GURL("https://www.a.com/x.js"),
+                              SiteHackAction::kBlock));
+  EXPECT_FALSE(table->FindRule(GURL("https://www.a.com/y.js"),
+                               SiteHackAction::kBlock));
+  EXPECT_FALSE(table->FindRule(GURL("https://sub.www.a.com/x.js"),
+                               SiteHackAction::kBlock));
+  EXPECT_TRUE(table->FindRule(GURL("https://b.com/"),
+                              SiteHackAction::kUserAgentWhitelist));
+  EXPECT_TRUE(table->FindRule(GURL("https://x.y.b.com/"),
+                              SiteHackAction::kUserAgentWhitelist));
+  EXPECT_FALSE(table->FindRule(GURL("https://notb.com/"),
+                               SiteHackAction::kUserAgentWhitelist));
+}
+
+TEST(SiteHacksRuleTableTest, FindsRulesInTableOrder) {
+  scoped_refptr<SiteHacksRuleTable> table = SiteHacksRuleTable::Parse(
+      "[{\"action\": \"user-agent-whitelist\","
+      " \"pattern\": \"https://*.a.com/*\"},"
+      "{\"action\": \"cookie-override\", \"pattern\": \"https://www.a.com/*\","
+      " \"value\": \"a=b\"}]");
+  ASSERT_TRUE(table);
+  std::vector<const SiteHackRule*> rules;
+  table->FindRules(GURL("https://www.a.com/"), &rules);
+  ASSERT_EQ(2u, rules.size());
+  EXPECT_EQ(SiteHackAction::kUserAgentWhitelist, rules[0]->action);
+  EXPECT_EQ(SiteHackAction::kCookieOverride, rules[1]->action);
+  EXPECT_EQ("a=b", rules[1]->value);
+}
+
+TEST(SiteHacksRuleTableTest, WhitelistsCheckFirstParty) {
+  scoped_refptr<SiteHacksRuleTable> table = SiteHacksRuleTable::Parse(
+      "[{\"action\": \"referrer-whitelist\", \"pattern\": \"https://a.com/*\","
+      " \"first-party\": \"https://b.com/*\"},"
+      "{\"action\": \"referrer-whitelist\", \"pattern\": \"https://c.com/*\"}]");
+  ASSERT_TRUE(table);
+  EXPECT_TRUE(table->MatchesWhitelist(SiteHackAction::kReferrerWhitelist,
+      GURL("https://b.com/"), GURL("https://a.com/")));
+  EXPECT_FALSE(table->MatchesWhitelist(SiteHackAction::kReferrerWhitelist,
+      GURL("https://d.com/"), GURL("https://a.com/")));
+  EXPECT_TRUE(table->MatchesWhitelist(SiteHackAction::kReferrerWhitelist,
+      GURL("https://d.com/"), GURL("https://c.com/")));
+  EXPECT_FALSE(table->MatchesWhitelist(SiteHackAction::kCookieWhitelist,
+      GURL("https://d.com/"), GURL("https://c.com/")));
+}
+
+TEST(SiteHacksRuleTableTest, IndexRoundTrips) {
+  scoped_refptr<SiteHacksRuleTable> table = SiteHacksRuleTable::Parse(
+      "[{\"action\": \"block-from-referrer\","
+      " \"pattern\": \"https://a.com/x*\", \"referrer\": \"https://b.com/*\"},"
+      "{\"action\": \"cookie-override\", \"pattern\": \"https://*.c.com/*\","
+      " \"value\": \"a=b\"}]");
+  ASSERT_TRUE(table);
+  std::string data;
+  table->Serialize(&data);
+
+  scoped_refptr<SiteHacksRuleTable> index =
+      SiteHacksRuleTable::ParseIndex(data);
+  ASSERT_TRUE(index);
+  EXPECT_EQ(2u, index->size());
+  const SiteHackRule* rule = index->FindRule(GURL("https://a.com/xyz"),
+      SiteHackAction::kBlockFromReferrer);
+  ASSERT_TRUE(rule);
+  EXPECT_TRUE(rule->referrer_pattern.MatchesURL(GURL("https://b.com/")));
+  rule = index->FindRule(GURL("https://www.c.com/"),
+                         SiteHackAction::kCookieOverride);
+  ASSERT_TRUE(rule);
+  EXPECT_EQ("a=b", rule->value);
+}
+
+TEST(SiteHacksRuleTableTest, InvalidIndex) {
+  EXPECT_FALSE(SiteHacksRuleTable::ParseIndex(""));
+  EXPECT_FALSE(SiteHacksRuleTable::ParseIndex("[]"));
+
+  scoped_refptr<SiteHacksRuleTable> table = SiteHacksRuleTable::Parse(
+      "[{\"action\": \"block\", \"pattern\": \"https://a.com/*\"}]");
+  ASSERT_TRUE(table);
+  std::string data;
+  table->Serialize(&data);
+  data.resize(data.size() - 1);
+  EXPECT_FALSE(SiteHacksRuleTable::ParseIndex(data));
+}
@@ -0,0 +1,119 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/site_hacks_service.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/lazy_instance.h"
+#include "base/logging.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/thread_restrictions.h"
+#include "brave/components/brave_shields/browser/site_hacks_rule_table.h"
+#include "brave/grit/brave_generated_resources.h"
+#include "ui/base/resource/resource_bundle.h"
+
+#define INDEX_FILE "SiteHacks.dat"
+#define INDEX_FILE_VERSION "1"
+
+namespace {
+
+struct CurrentRules {
+  CurrentRules() {
+    rules = brave_shields::SiteHacksRuleTable::Parse(
+        ui::ResourceBundle::GetSharedInstance().GetRawDataResource(
+            IDR_BRAVE_SITE_HACKS_RULES));
+    if (!rules) {
+      LOG(ERROR) << "Could not parse the built-in site hacks";
+      rules = brave_shields::SiteHacksRuleTable::Parse("[]");
+    }
+  }
+
+  // Only held to swap or copy |rules|, never while matching.
+  base::Lock lock;
+  scoped_refptr<const brave_shields::SiteHacksRuleTable> rules;
+};
+
+base::LazyInstance<CurrentRules>::Leaky g_current_rules =
+    LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
+namespace brave_shields {
+
+SiteHacksService::SiteHacksService() {
+}
+
+SiteHacksService::~SiteHacksService() {
+  Cleanup();
+}
+
+// static
+scoped_refptr<const SiteHacksRuleTable> SiteHacksService::GetRules() {
+  CurrentRules& current = g_current_rules.Get();
+  base::AutoLock lock(current.lock);
+  return current.rules;
+}
+
+// static
+void SiteHacksService::SetRules(
+    scoped_refptr<const SiteHacksRuleTable> rules) {
+  CurrentRules& current = g_current_rules.Get();
+  scoped_refptr<const SiteHacksRuleTable> old_rules;
+  {
+    base::AutoLock lock(current.lock);
+    old_rules = std::move(current.rules);
+    current.rules = std::move(rules);
+  }
+  // |old_rules| is released here, outside of the lock.
+}
+
+bool SiteHacksService::Init() {
+  Register(kSiteHacksComponentName,
+           kSiteHacksComponentId,
+           kSiteHacksComponentBase64PublicKey);
+  return true;
+}
+
+void SiteHacksService::Cleanup() {
+}
+
+void SiteHacksService::OnComponentReady(
+    const std::string& component_id,
+    const base::FilePath& install_dir) {
+  base::FilePath index_path =
+      install_dir.AppendASCII(INDEX_FILE_VERSION).AppendASCII(INDEX_FILE);
+  GetTaskRunner()->PostTask(FROM_HERE,
+      base::BindOnce(&SiteHacksService::LoadRules, index_path));
+}
+
+// static
+void SiteHacksService::LoadRules(const base::FilePath& index_path) {
+  base::AssertBlockingAllowed();
+  std::string data;
+  if (!base::ReadFileToString(index_path, &data)) {
+    LOG(ERROR) << "Could not read site hacks " << index_path.value();
+    return;
+  }
+  // Everything is parsed here, so the swap is all the IO thread sees.
+  scoped_refptr<SiteHacksRuleTable> rules =
+      SiteHacksRuleTable::ParseIndex(data);
+  if (!rules) {
+    LOG(ERROR) << "Invalid site hacks " << index_path.value();
+    return;
+  }
+  SetRules(std::move(rules));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// The brave shields factory. Using the Brave Shields as a singleton
+// is the job of the browser process.
+std::unique_ptr<SiteHacksService> SiteHacksServiceFactory() {
+  return std::make_unique<SiteHacksService>();
+}
+
+}  // namespace brave_shields
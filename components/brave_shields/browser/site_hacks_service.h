@@ -0,0 +1,62 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SITE_HACKS_SERVICE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SITE_HACKS_SERVICE_H_
+
+#include <memory>
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "brave/components/brave_shields/browser/base_brave_shields_service.h"
+
+namespace brave_shields {
+
+class SiteHacksRuleTable;
+
+const std::string kSiteHacksComponentName("Brave Site Hacks Updater");
+const std::string kSiteHacksComponentId("nalhgaiacclbpilmdggfgehgfkjliicl");
+
+const std::string kSiteHacksComponentBase64PublicKey =
+    "MIIBIjANBgkqhkiG9w0BAQEFAAOCAQ8AMIIBCgKCAQEAorhgDodaRlPsd83LOh2c"
+    "Hum+6euFrkDvhvkX0/QmoOK8Jn5WVDsblLB4Ch2W05dXOiS3SA+aO5GKUxLYEz1I"
+    "8Db10ZNj7Q414Oj25IiRrYiboPKEr/wZMA5ScJZ7nm5R7vIRocWSr9goAR39cElP"
+    "tgfg1se0zfqINdbrUNxHb+HqZTtUwSyagpV7FLwvC63QcCJPRLrP6yhI4ZRjOWEw"
+    "6GjpDX/clAqe70re/uGuVdGNh9juQ2je62KwPaQo9PswziKji45hWi7u24gX2s4K"
+    "W89GI3N2HN/w9Ev8gK/pctEOOe8h/iRJpoeISTOw8T58DNoKPaa8Ks0GUhFGEUQ2"
+    "lQIDAQAB";
+
+// Keeps the site hacks and shield exceptions up to date. The rules built
+// into the browser are used until the component delivers a newer index,
+// which then replaces them in one step for all threads.
+class SiteHacksService : public BaseBraveShieldsService {
+ public:
+  SiteHacksService();
+  ~SiteHacksService() override;
+
+  // The rules in effect. May be called from any thread; the result stays
+  // valid even if newer rules arrive meanwhile.
+  static scoped_refptr<const SiteHacksRuleTable> GetRules();
+
+ protected:
+  bool Init() override;
+  void Cleanup() override;
+  void OnComponentReady(const std::string& component_id,
+      const base::FilePath& install_dir) override;
+
+ private:
+  static void SetRules(scoped_refptr<const SiteHacksRuleTable> rules);
+  static void LoadRules(const base::FilePath& index_path);
+
+  DISALLOW_COPY_AND_ASSIGN(SiteHacksService);
+};
+
+// Creates the SiteHacksService
+std::unique_ptr<SiteHacksService> SiteHacksServiceFactory();
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SITE_HACKS_SERVICE_H_
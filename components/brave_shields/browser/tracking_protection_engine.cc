@@ -0,0 +1,81 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/tracking_protection_engine.h"
+
+#include <utility>
+
+#include "base/files/memory_mapped_file.h"
+#include "base/logging.h"
+#include "base/strings/string_split.h"
+#include "base/threading/thread_restrictions.h"
+#include "brave/components/brave_shields/browser/shields_latency_tracker.h"
+#include "brave/vendor/tracking-protection/TPParser.h"
+
+namespace brave_shields {
+
+TrackingProtectionEngine::TrackingProtectionEngine(
+    size_t third_party_hosts_cache_size)
+    : third_party_hosts_cache_(third_party_hosts_cache_size) {
+}
+
+TrackingProtectionEngine::~TrackingProtectionEngine() {
+}
+
+// static
+scoped_refptr<TrackingProtectionEngine> TrackingProtectionEngine::Create(
+    std::unique_ptr<DATFileData> dat_file_data,
+    size_t third_party_hosts_cache_size) {
+  base::AssertBlockingAllowed();
+  if (!dat_file_data) {
+    return nullptr;
+  }
+  scoped_refptr<TrackingProtectionEngine> engine(
+      new TrackingProtectionEngine(third_party_hosts_cache_size));
+  engine->dat_file_data_ = std::move(dat_file_data);
+  engine->tracking_protection_client_.reset(new CTPParser());
+  if (!engine->tracking_protection_client_->deserialize(
+          GetDATFileDataPointer(engine->dat_file_data_.get()))) {
+    LOG(ERROR) << "Failed to deserialize tracking protection data";
+    return nullptr;
+  }
+  return engine;
+}
+
+bool TrackingProtectionEngine::MatchesTracker(const std::string& tab_host,
+                                              const std::string& host) {
+  return tracking_protection_client_->matchesTracker(tab_host.c_str(),
+                                                     host.c_str());
+}
+
+// Ported from Android: net/blockers/blockers_worker.cc
+scoped_refptr<const ThirdPartyHosts>
+TrackingProtectionEngine::GetThirdPartyHosts(const std::string& base_host) {
+  scoped_refptr<const ThirdPartyHosts> third_party_hosts;
+  const bool cached =
+      third_party_hosts_cache_.Get(base_host, &third_party_hosts);
+  ShieldsLatencyTracker::GetInstance()->RecordCacheLookup(
+      ShieldsLatencyStage::kTrackingProtectionMatch, cached);
+  if (cached) {
+    return third_party_hosts;
+  }
+
+  scoped_refptr<ThirdPartyHosts> hosts(new ThirdPartyHosts());
+  char* thirdPartyHosts =
+    tracking_protection_client_->findFirstPartyHosts(base_host.c_str());
+  if (nullptr != thirdPartyHosts) {
+    for (const base::StringPiece& host :
+         base::SplitStringPiece(thirdPartyHosts, ",", base::KEEP_WHITESPACE,
+                                base::SPLIT_WANT_NONEMPTY)) {
+      hosts->data.Add(host);
+    }
+    delete []thirdPartyHosts;
+  }
+
+  third_party_hosts = hosts;
+  third_party_hosts_cache_.Add(base_host, third_party_hosts);
+  return third_party_hosts;
+}
+
+}  // namespace brave_shields
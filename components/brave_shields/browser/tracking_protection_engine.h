@@ -0,0 +1,65 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_TRACKING_PROTECTION_ENGINE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_TRACKING_PROTECTION_ENGINE_H_
+
+#include <memory>
+#include <string>
+
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "brave/components/brave_shields/browser/dat_file_util.h"
+#include "brave/components/brave_shields/browser/host_label_trie.h"
+#include "brave/components/brave_shields/browser/sharded_lru_cache.h"
+
+class CTPParser;
+
+namespace brave_shields {
+
+// The hosts which are first party to a site, never modified once built so
+// that cache readers can share them.
+using ThirdPartyHosts = base::RefCountedData<HostLabelTrie>;
+
+// A deserialized tracking protection list together with the DAT data it
+// points into and the first party hosts looked up from it. Engines are built
+// on the service task runner and then published as a whole, so a list update
+// never unmaps data requests are being matched against, and lookups still
+// running against the old list only fill the old list's cache.
+class TrackingProtectionEngine
+    : public base::RefCountedThreadSafe<TrackingProtectionEngine> {
+ public:
+  // Deserializes |dat_file_data|. Returns nullptr if it does not hold a valid
+  // tracking protection list. Must be called where blocking is allowed since
+  // it pages the mapping in. |third_party_hosts_cache_size| bounds the number
+  // of sites whose first party hosts are remembered.
+  static scoped_refptr<TrackingProtectionEngine> Create(
+      std::unique_ptr<DATFileData> dat_file_data,
+      size_t third_party_hosts_cache_size);
+
+  // Returns true if |host| is a tracker when loaded from |tab_host|.
+  bool MatchesTracker(const std::string& tab_host, const std::string& host);
+
+  // Returns the hosts the list considers first party to |base_host|.
+  scoped_refptr<const ThirdPartyHosts> GetThirdPartyHosts(
+      const std::string& base_host);
+
+ private:
+  friend class base::RefCountedThreadSafe<TrackingProtectionEngine>;
+
+  explicit TrackingProtectionEngine(size_t third_party_hosts_cache_size);
+  ~TrackingProtectionEngine();
+
+  std::unique_ptr<DATFileData> dat_file_data_;
+  // Points into |dat_file_data_|, so it is declared after it.
+  std::unique_ptr<CTPParser> tracking_protection_client_;
+  ShardedLRUCache<scoped_refptr<const ThirdPartyHosts>>
+      third_party_hosts_cache_;
+
+  DISALLOW_COPY_AND_ASSIGN(TrackingProtectionEngine);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_TRACKING_PROTECTION_ENGINE_H_
@@ -13,13 +13,39 @@
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task_runner_util.h"
 #include "base/threading/thread_restrictions.h"
 #include "brave/components/brave_shields/browser/dat_file_util.h"
-#include "brave/vendor/tracking-protection/TPParser.h"
 
 #define DAT_FILE "TrackingProtection.dat"
 #define DAT_FILE_VERSION "1"
-#define THIRD_PARTY_HOSTS_CACHE_SIZE 20
+#define THIRD_PARTY_HOSTS_CACHE_SIZE 1000
+
+namespace {
+
+// See comment in tracking_protection_service.h for white_list_
+const char* const kWhiteListedHosts[] = {
+  "connect.facebook.net",
+  "connect.facebook.com",
+  "staticxx.facebook.com",
+  "www.facebook.com",
+  "scontent.xx.fbcdn.net",
+  "pbs.twimg.com",
+  "scontent-sjc2-1.xx.fbcdn.net",
+  "platform.twitter.com",
+  "syndication.twitter.com",
+  "cdn.syndication.twimg.com"
+};
+
+scoped_refptr<brave_shields::TrackingProtectionEngine> LoadEngine(
+    const base::FilePath& dat_file_path,
+    size_t third_party_hosts_cache_size) {
+  return brave_shields::TrackingProtectionEngine::Create(
+      brave_shields::GetDATFileData(dat_file_path),
+      third_party_hosts_cache_size);
+}
+
+}  // namespace
 
 namespace brave_shields {
 
@@ -29,21 +55,16 @@ std::string TrackingProtectionService::g_tracking_protection_component_base64_pu
     kTrackingProtectionComponentBase64PublicKey);
 
 TrackingProtectionService::TrackingProtectionService()
-  : tracking_protection_client_(new CTPParser()),
-    // See comment in tracking_protection_service.h for white_list_
-    white_list_({
-      "connect.facebook.net",
-      "connect.facebook.com",
-      "staticxx.facebook.com",
-      "www.facebook.com",
-      "scontent.xx.fbcdn.net",
-      "pbs.twimg.com",
-      "scontent-sjc2-1.xx.fbcdn.net",
-      "platform.twitter.com",
-      "syndication.twitter.com",
-      "cdn.syndication.twimg.com"
-    }),
+    : TrackingProtectionService(THIRD_PARTY_HOSTS_CACHE_SIZE) {
+}
+
+TrackingProtectionService::TrackingProtectionService(
+    size_t third_party_hosts_cache_size)
+  : third_party_hosts_cache_size_(third_party_hosts_cache_size),
     weak_factory_(this) {
+  for (const char* host : kWhiteListedHosts) {
+    white_list_.Add(host);
+  }
 }
 
 TrackingProtectionService::~TrackingProtectionService() {
@@ -51,39 +72,28 @@ TrackingProtectionService::~TrackingProtectionService() {
 }
 
 void TrackingProtectionService::Cleanup() {
-  tracking_protection_client_.reset();
+  base::AutoLock lock(engine_lock_);
+  engine_ = nullptr;
 }
 
 bool TrackingProtectionService::ShouldStartRequest(const GURL& url,
     content::ResourceType resource_type,
     const std::string &tab_host) {
-  std::string host = url.host();
-  if (!tracking_protection_client_->matchesTracker(
-        tab_host.c_str(), host.c_str())) {
+  scoped_refptr<TrackingProtectionEngine> engine = GetEngine();
+  if (!engine) {
     return true;
   }
-
-  std::vector<std::string> hosts(GetThirdPartyHosts(tab_host));
-  for (size_t i = 0; i < hosts.size(); i++) {
-    if (host == hosts[i] ||
-        host.find((std::string)"." + hosts[i]) != std::string::npos) {
-      return true;
-    }
-    size_t iPos = host.find((std::string)"." + hosts[i]);
-    if (iPos == std::string::npos) {
-      continue;
-    }
-    if (hosts[i].length() + ((std::string)".").length() + iPos ==
-        host.length()) {
-      return true;
-    }
+  std::string host = url.host();
+  if (!engine->MatchesTracker(tab_host, host)) {
+    return true;
   }
 
-  if (std::find(white_list_.begin(), white_list_.end(), host) !=
-      white_list_.end()) {
+  // First party hosts of the site and their subdomains are never blocked.
+  if (engine->GetThirdPartyHosts(tab_host)->data.Matches(host, true)) {
     return true;
   }
-  return false;
+
+  return white_list_.Matches(host, false);
 }
 
 bool TrackingProtectionService::Init() {
@@ -93,85 +103,37 @@ bool TrackingProtectionService::Init() {
   return true;
 }
 
-void TrackingProtectionService::OnDATFileDataReady() {
-  if (buffer_.empty()) {
+void TrackingProtectionService::OnEngineReady(
+    scoped_refptr<TrackingProtectionEngine> engine) {
+  if (!engine) {
     LOG(ERROR) << "Could not obtain tracking protection data";
     return;
   }
-  tracking_protection_client_.reset(new CTPParser());
-  if (!tracking_protection_client_->deserialize((char*)&buffer_.front())) {
-    tracking_protection_client_.reset();
-    LOG(ERROR) << "Failed to deserialize tracking protection data";
+  {
+    base::AutoLock lock(engine_lock_);
+    engine_ = std::move(engine);
   }
 }
 
+scoped_refptr<TrackingProtectionEngine>
+TrackingProtectionService::GetEngine() const {
+  base::AutoLock lock(engine_lock_);
+  return engine_;
+}
+
 void TrackingProtectionService::OnComponentReady(
     const std::string& component_id,
     const base::FilePath& install_dir) {
   base::FilePath dat_file_path =
       install_dir.AppendASCII(DAT_FILE_VERSION).AppendASCII(DAT_FILE);
 
-  GetTaskRunner()->PostTaskAndReply(
+  base::PostTaskAndReplyWithResult(
+      GetTaskRunner().get(),
       FROM_HERE,
-      base::Bind(&GetDATFileData, dat_file_path, &buffer_),
-      base::Bind(&TrackingProtectionService::OnDATFileDataReady,
-                 weak_factory_.GetWeakPtr()));
-}
-
-// Ported from Android: net/blockers/blockers_worker.cc
-std::vector<std::string>
-TrackingProtectionService::GetThirdPartyHosts(const std::string& base_host) {
-  {
-    std::lock_guard<std::mutex> guard(third_party_hosts_mutex_);
-    std::map<std::string, std::vector<std::string>>::const_iterator iter =
-      third_party_hosts_cache_.find(base_host);
-    if (third_party_hosts_cache_.end() != iter) {
-      if (third_party_base_hosts_.size() != 0
-          && third_party_base_hosts_[third_party_hosts_cache_.size() - 1] !=
-          base_host) {
-        for (size_t i = 0; i < third_party_base_hosts_.size(); i++) {
-          if (third_party_base_hosts_[i] == base_host) {
-            third_party_base_hosts_.erase(third_party_base_hosts_.begin() + i);
-            third_party_base_hosts_.push_back(base_host);
-            break;
-          }
-        }
-      }
-      return iter->second;
-    }
-  }
-
-  char* thirdPartyHosts =
-    tracking_protection_client_->findFirstPartyHosts(base_host.c_str());
-  std::vector<std::string> hosts;
-  if (nullptr != thirdPartyHosts) {
-    std::string strThirdPartyHosts = thirdPartyHosts;
-    size_t iPos = strThirdPartyHosts.find(",");
-    while (iPos != std::string::npos) {
-      std::string thirdParty = strThirdPartyHosts.substr(0, iPos);
-      strThirdPartyHosts = strThirdPartyHosts.substr(iPos + 1);
-      iPos = strThirdPartyHosts.find(",");
-      hosts.push_back(thirdParty);
-    }
-    if (0 != strThirdPartyHosts.length()) {
-      hosts.push_back(strThirdPartyHosts);
-    }
-    delete []thirdPartyHosts;
-  }
-
-  {
-    std::lock_guard<std::mutex> guard(third_party_hosts_mutex_);
-    if (third_party_hosts_cache_.size() == THIRD_PARTY_HOSTS_CACHE_SIZE &&
-        third_party_base_hosts_.size() == THIRD_PARTY_HOSTS_CACHE_SIZE) {
-      third_party_hosts_cache_.erase(third_party_base_hosts_[0]);
-      third_party_base_hosts_.erase(third_party_base_hosts_.begin());
-    }
-    third_party_base_hosts_.push_back(base_host);
-    third_party_hosts_cache_.insert(
-        std::pair<std::string, std::vector<std::string>>(base_host, hosts));
-  }
-
-  return hosts;
+      base::BindOnce(&LoadEngine, dat_file_path,
+                     third_party_hosts_cache_size_),
+      base::BindOnce(&TrackingProtectionService::OnEngineReady,
+                     weak_factory_.GetWeakPtr()));
 }
 
 // static
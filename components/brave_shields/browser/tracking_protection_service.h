@@ -7,19 +7,19 @@
 
 #include <stdint.h>
 
-#include <map>
 #include <memory>
-#include <mutex>
 #include <string>
 #include <vector>
 
 #include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
+#include "base/synchronization/lock.h"
 #include "brave/components/brave_shields/browser/base_brave_shields_service.h"
-#include "brave/components/brave_shields/browser/dat_file_util.h"
+#include "brave/components/brave_shields/browser/host_label_trie.h"
+#include "brave/components/brave_shields/browser/tracking_protection_engine.h"
 #include "content/public/common/resource_type.h"
 
-class CTPParser;
 class TrackingProtectionServiceTest;
 
 namespace brave_shields {
@@ -40,6 +40,9 @@ const std::string kTrackingProtectionComponentBase64PublicKey =
 class TrackingProtectionService : public BaseBraveShieldsService {
  public:
   TrackingProtectionService();
+  // |third_party_hosts_cache_size| bounds the number of sites whose first
+  // party hosts are remembered.
+  explicit TrackingProtectionService(size_t third_party_hosts_cache_size);
   ~TrackingProtectionService() override;
 
   bool ShouldStartRequest(const GURL& spec,
@@ -60,17 +63,18 @@ class TrackingProtectionService : public BaseBraveShieldsService {
       const std::string& component_id,
       const std::string& component_base64_public_key);
 
-  void OnDATFileDataReady();
-  std::vector<std::string> GetThirdPartyHosts(const std::string& base_host);
+  void OnEngineReady(scoped_refptr<TrackingProtectionEngine> engine);
+  // Returns the current engine, or nullptr if no list is loaded yet.
+  scoped_refptr<TrackingProtectionEngine> GetEngine() const;
 
-  brave_shields::DATFileDataBuffer buffer_;
-
-  std::unique_ptr<CTPParser> tracking_protection_client_;
+  // Guards |engine_|, which is swapped on the owning thread and read on the
+  // IO thread.
+  mutable base::Lock engine_lock_;
+  scoped_refptr<TrackingProtectionEngine> engine_;
   // TODO: Temporary hack which matches both browser-laptop and Android code
-  std::vector<std::string> white_list_;
-  std::vector<std::string> third_party_base_hosts_;
-  std::map<std::string, std::vector<std::string>> third_party_hosts_cache_;
-  std::mutex third_party_hosts_mutex_;
+  HostLabelTrie white_list_;
+  // Passed to every engine, each of which keeps its own cache.
+  const size_t third_party_hosts_cache_size_;
 
   base::WeakPtrFactory<TrackingProtectionService> weak_factory_;
 
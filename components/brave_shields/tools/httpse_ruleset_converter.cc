@@ -0,0 +1,71 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+// Converts the HTTPS Everywhere LevelDB database into the flat ruleset file
+// read by HTTPSERulesetIndex.
+//
+// Usage: httpse_ruleset_converter <leveldb directory> <output file>
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "base/command_line.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/logging.h"
+#include "brave/components/brave_shields/browser/https_everywhere_ruleset_index.h"
+#include "third_party/leveldatabase/src/include/leveldb/db.h"
+
+int main(int argc, char* argv[]) {
+  base::CommandLine::Init(argc, argv);
+  const base::CommandLine::StringVector args =
+      base::CommandLine::ForCurrentProcess()->GetArgs();
+  if (args.size() != 2) {
+    LOG(ERROR) << "Usage: httpse_ruleset_converter "
+               << "<leveldb directory> <output file>";
+    return 1;
+  }
+  const base::FilePath level_db_path(args[0]);
+  const base::FilePath output_path(args[1]);
+
+  leveldb::DB* db = nullptr;
+  leveldb::Options options;
+  leveldb::Status status =
+      leveldb::DB::Open(options, level_db_path.AsUTF8Unsafe(), &db);
+  if (!status.ok() || !db) {
+    LOG(ERROR) << "Level db open error " << level_db_path.value()
+               << ", error: " << status.ToString();
+    return 1;
+  }
+  std::unique_ptr<leveldb::DB> db_owner(db);
+
+  std::map<std::string, std::string> rulesets;
+  std::unique_ptr<leveldb::Iterator> it(
+      db->NewIterator(leveldb::ReadOptions()));
+  for (it->SeekToFirst(); it->Valid(); it->Next()) {
+    rulesets[it->key().ToString()] = it->value().ToString();
+  }
+  if (!it->status().ok()) {
+    LOG(ERROR) << "Level db read error: " << it->status().ToString();
+    return 1;
+  }
+
+  std::string output;
+  brave_shields::HTTPSERulesetIndex::Serialize(rulesets, &output);
+  if (base::WriteFile(output_path, output.data(), output.size()) !=
+      static_cast<int>(output.size())) {
+    LOG(ERROR) << "Failed to write " << output_path.value();
+    return 1;
+  }
+
+  // Make sure what we wrote can be read back.
+  scoped_refptr<brave_shields::HTTPSERulesetIndex> index =
+      brave_shields::HTTPSERulesetIndex::Load(output_path);
+  if (!index || index->size() != rulesets.size()) {
+    LOG(ERROR) << "Verification of " << output_path.value() << " failed";
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,389 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+// Replays a recorded request corpus through the shields matchers, in process
+// and without a browser, and reports requests per second, heap allocations
+// per request and the resident memory taken by each matcher.
+//
+// Usage: shields_matching_benchmark --corpus=<file>
+//            [--adblock-dir=<dir>] [--tracking-protection-dir=<dir>]
+//            [--httpse-dir=<dir>] [--iterations=<n>]
+//
+// The directories are component install directories, laid out like the ones
+// under brave/test/data. The corpus holds one request per line:
+// "<url> <resource type> <tab host>", resource types being named as in
+// kResourceTypes below. Lines starting with # are ignored.
+//
+// The first pass over the corpus is reported separately since it fills the
+// caches of the services.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/allocator/buildflags.h"
+#include "base/at_exit.h"
+#include "base/command_line.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/logging.h"
+#include "base/process/process_metrics.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "base/test/scoped_task_environment.h"
+#include "base/time/time.h"
+#include "brave/components/brave_shields/browser/ad_block_service.h"
+#include "brave/components/brave_shields/browser/brave_shields_resource_throttle.h"
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "brave/components/brave_shields/browser/https_everywhere_service.h"
+#include "brave/components/brave_shields/browser/tracking_protection_service.h"
+#include "content/public/common/resource_type.h"
+#include "url/gurl.h"
+
+#if BUILDFLAG(USE_ALLOCATOR_SHIM)
+#include "base/allocator/allocator_shim.h"
+#endif
+
+namespace {
+
+const char kCorpusSwitch[] = "corpus";
+const char kAdBlockDirSwitch[] = "adblock-dir";
+const char kTrackingProtectionDirSwitch[] = "tracking-protection-dir";
+const char kHTTPSEDirSwitch[] = "httpse-dir";
+const char kIterationsSwitch[] = "iterations";
+
+const int kDefaultIterations = 100;
+
+const struct {
+  const char* name;
+  content::ResourceType type;
+} kResourceTypes[] = {
+  { "main_frame", content::RESOURCE_TYPE_MAIN_FRAME },
+  { "sub_frame", content::RESOURCE_TYPE_SUB_FRAME },
+  { "stylesheet", content::RESOURCE_TYPE_STYLESHEET },
+  { "script", content::RESOURCE_TYPE_SCRIPT },
+  { "image", content::RESOURCE_TYPE_IMAGE },
+  { "font_resource", content::RESOURCE_TYPE_FONT_RESOURCE },
+  { "sub_resource", content::RESOURCE_TYPE_SUB_RESOURCE },
+  { "object", content::RESOURCE_TYPE_OBJECT },
+  { "media", content::RESOURCE_TYPE_MEDIA },
+  { "xhr", content::RESOURCE_TYPE_XHR },
+  { "ping", content::RESOURCE_TYPE_PING },
+};
+
+std::atomic<uint64_t> g_allocation_count(0);
+
+#if BUILDFLAG(USE_ALLOCATOR_SHIM)
+using base::allocator::AllocatorDispatch;
+
+void* CountingAlloc(const AllocatorDispatch* self, size_t size,
+                    void* context) {
+  g_allocation_count++;
+  return self->next->alloc_function(self->next, size, context);
+}
+
+void* CountingAllocZeroInitialized(const AllocatorDispatch* self, size_t n,
+                                   size_t size, void* context) {
+  g_allocation_count++;
+  return self->next->alloc_zero_initialized_function(self->next, n, size,
+                                                     context);
+}
+
+void* CountingAllocAligned(const AllocatorDispatch* self, size_t alignment,
+                           size_t size, void* context) {
+  g_allocation_count++;
+  return self->next->alloc_aligned_function(self->next, alignment, size,
+                                            context);
+}
+
+void* CountingRealloc(const AllocatorDispatch* self, void* address,
+                      size_t size, void* context) {
+  g_allocation_count++;
+  return self->next->realloc_function(self->next, address, size, context);
+}
+
+void CountingFree(const AllocatorDispatch* self, void* address,
+                  void* context) {
+  self->next->free_function(self->next, address, context);
+}
+
+size_t CountingGetSizeEstimate(const AllocatorDispatch* self, void* address,
+                               void* context) {
+  return self->next->get_size_estimate_function(self->next, address, context);
+}
+
+unsigned CountingBatchMalloc(const AllocatorDispatch* self, size_t size,
+                             void** results, unsigned num_requested,
+                             void* context) {
+  unsigned count = self->next->batch_malloc_function(self->next, size,
+      results, num_requested, context);
+  g_allocation_count += count;
+  return count;
+}
+
+void CountingBatchFree(const AllocatorDispatch* self, void** to_be_freed,
+                       unsigned num_to_be_freed, void* context) {
+  self->next->batch_free_function(self->next, to_be_freed, num_to_be_freed,
+                                  context);
+}
+
+void CountingFreeDefiniteSize(const AllocatorDispatch* self, void* address,
+                              size_t size, void* context) {
+  self->next->free_definite_size_function(self->next, address, size, context);
+}
+
+AllocatorDispatch g_counting_dispatch = {
+  &CountingAlloc,
+  &CountingAllocZeroInitialized,
+  &CountingAllocAligned,
+  &CountingRealloc,
+  &CountingFree,
+  &CountingGetSizeEstimate,
+  &CountingBatchMalloc,
+  &CountingBatchFree,
+  &CountingFreeDefiniteSize,
+  nullptr,
+};
+#endif  // BUILDFLAG(USE_ALLOCATOR_SHIM)
+
+struct CorpusEntry {
+  GURL url;
+  content::ResourceType resource_type;
+  std::string tab_host;
+};
+
+bool LoadCorpus(const base::FilePath& path, std::vector<CorpusEntry>* corpus) {
+  std::string contents;
+  if (!base::ReadFileToString(path, &contents)) {
+    LOG(ERROR) << "Could not read " << path.value();
+    return false;
+  }
+  for (const base::StringPiece& line :
+       base::SplitStringPiece(contents, "\n", base::TRIM_WHITESPACE,
+                              base::SPLIT_WANT_NONEMPTY)) {
+    if (line.starts_with("#")) {
+      continue;
+    }
+    std::vector<base::StringPiece> fields = base::SplitStringPiece(
+        line, " \t", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+    if (fields.size() != 3) {
+      LOG(ERROR) << "Malformed corpus line: " << line;
+      return false;
+    }
+    CorpusEntry entry;
+    entry.url = GURL(fields[0]);
+    bool known_type = false;
+    for (const auto& resource_type : kResourceTypes) {
+      if (fields[1] == resource_type.name) {
+        entry.resource_type = resource_type.type;
+        known_type = true;
+        break;
+      }
+    }
+    if (!entry.url.is_valid() || !known_type) {
+      LOG(ERROR) << "Malformed corpus line: " << line;
+      return false;
+    }
+    entry.tab_host = fields[2].as_string();
+    corpus->push_back(std::move(entry));
+  }
+  return !corpus->empty();
+}
+
+// Read from /proc/self/statm, this benchmark is meant for Linux.
+size_t GetResidentSetSize() {
+  std::string statm;
+  if (!base::ReadFileToString(base::FilePath("/proc/self/statm"), &statm)) {
+    return 0;
+  }
+  std::vector<base::StringPiece> fields = base::SplitStringPiece(
+      statm, " ", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+  size_t resident_pages = 0;
+  if (fields.size() < 2 ||
+      !base::StringToSizeT(fields[1], &resident_pages)) {
+    return 0;
+  }
+  return resident_pages * base::GetPageSize();
+}
+
+// Runs |match| over |corpus| |iterations| times and prints the results.
+// |match| returns true when the request is blocked or rewritten.
+template <typename Matcher>
+void RunBenchmark(const std::string& name,
+                  const std::vector<CorpusEntry>& corpus,
+                  int iterations,
+                  Matcher match) {
+  size_t matched = 0;
+  for (int pass = 0; pass < 2; pass++) {
+    const int pass_iterations = pass == 0 ? 1 : iterations - 1;
+    if (pass_iterations <= 0) {
+      break;
+    }
+    const uint64_t allocations_before = g_allocation_count;
+    const base::TimeTicks start = base::TimeTicks::Now();
+    for (int i = 0; i < pass_iterations; i++) {
+      for (const CorpusEntry& entry : corpus) {
+        if (match(entry) && pass == 0) {
+          matched++;
+        }
+      }
+    }
+    const base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+    const double requests =
+        static_cast<double>(corpus.size()) * pass_iterations;
+    printf("%-20s %-5s %12.0f requests/s %8.2f allocations/request\n",
+           name.c_str(), pass == 0 ? "cold" : "warm",
+           requests / elapsed.InSecondsF(),
+           (g_allocation_count - allocations_before) / requests);
+  }
+  printf("%-20s %zu of %zu requests matched\n", name.c_str(), matched,
+         corpus.size());
+}
+
+// The services only expose loading through the component updater.
+class BenchmarkAdBlockService : public brave_shields::AdBlockService {
+ public:
+  using brave_shields::AdBlockService::OnComponentReady;
+};
+
+class BenchmarkTrackingProtectionService
+    : public brave_shields::TrackingProtectionService {
+ public:
+  using brave_shields::TrackingProtectionService::OnComponentReady;
+};
+
+class BenchmarkHTTPSEverywhereService
+    : public brave_shields::HTTPSEverywhereService {
+ public:
+  using brave_shields::HTTPSEverywhereService::OnComponentReady;
+};
+
+// Loads the component in |install_dir| into |service| and prints how much
+// resident memory that took.
+template <typename Service>
+void LoadComponent(const std::string& name,
+                   Service* service,
+                   const base::FilePath& install_dir,
+                   base::test::ScopedTaskEnvironment* task_environment) {
+  const size_t rss_before = GetResidentSetSize();
+  service->OnComponentReady(std::string(), install_dir);
+  task_environment->RunUntilIdle();
+  const size_t rss_after = GetResidentSetSize();
+  printf("%-20s %8zu KB resident after load\n", name.c_str(),
+         rss_after > rss_before ? (rss_after - rss_before) / 1024 : 0);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  base::AtExitManager at_exit;
+  base::CommandLine::Init(argc, argv);
+  const base::CommandLine* command_line =
+      base::CommandLine::ForCurrentProcess();
+
+  std::vector<CorpusEntry> corpus;
+  if (!command_line->HasSwitch(kCorpusSwitch) ||
+      !LoadCorpus(command_line->GetSwitchValuePath(kCorpusSwitch), &corpus)) {
+    LOG(ERROR) << "Usage: shields_matching_benchmark --corpus=<file> "
+               << "[--adblock-dir=<dir>] [--tracking-protection-dir=<dir>] "
+               << "[--httpse-dir=<dir>] [--iterations=<n>]";
+    return 1;
+  }
+  int iterations = kDefaultIterations;
+  if (command_line->HasSwitch(kIterationsSwitch) &&
+      (!base::StringToInt(
+           command_line->GetSwitchValueASCII(kIterationsSwitch),
+           &iterations) ||
+       iterations < 1)) {
+    LOG(ERROR) << "--iterations must be a positive number";
+    return 1;
+  }
+
+#if BUILDFLAG(USE_ALLOCATOR_SHIM)
+  base::allocator::InsertAllocatorDispatch(&g_counting_dispatch);
+#else
+  printf("Allocations are not counted, the allocator shim is disabled.\n");
+#endif
+
+  base::test::ScopedTaskEnvironment task_environment;
+  printf("%zu requests, %d iterations\n", corpus.size(), iterations);
+
+  // Older HTTPS Everywhere components are unzipped in place, so work on a
+  // copy.
+  base::ScopedTempDir httpse_dir;
+  BenchmarkAdBlockService ad_block_service;
+  BenchmarkTrackingProtectionService tracking_protection_service;
+  BenchmarkHTTPSEverywhereService https_everywhere_service;
+
+  if (command_line->HasSwitch(kAdBlockDirSwitch)) {
+    LoadComponent("ad-block", &ad_block_service,
+        command_line->GetSwitchValuePath(kAdBlockDirSwitch),
+        &task_environment);
+    RunBenchmark("ad-block", corpus, iterations,
+        [&](const CorpusEntry& entry) {
+          return !ad_block_service.ShouldStartRequestForAllLists(
+              entry.url, entry.resource_type, entry.tab_host, nullptr);
+        });
+  }
+
+  if (command_line->HasSwitch(kTrackingProtectionDirSwitch)) {
+    LoadComponent("tracking-protection", &tracking_protection_service,
+        command_line->GetSwitchValuePath(kTrackingProtectionDirSwitch),
+        &task_environment);
+    RunBenchmark("tracking-protection", corpus, iterations,
+        [&](const CorpusEntry& entry) {
+          return !tracking_protection_service.ShouldStartRequest(
+              entry.url, entry.resource_type, entry.tab_host);
+        });
+  }
+
+  if (command_line->HasSwitch(kHTTPSEDirSwitch)) {
+    if (!httpse_dir.CreateUniqueTempDir() ||
+        !base::CopyDirectory(
+            command_line->GetSwitchValuePath(kHTTPSEDirSwitch),
+            httpse_dir.GetPath(), true)) {
+      LOG(ERROR) << "Could not copy the HTTPS Everywhere component";
+      return 1;
+    }
+    const base::FilePath install_dir = httpse_dir.GetPath().Append(
+        command_line->GetSwitchValuePath(kHTTPSEDirSwitch).BaseName());
+    LoadComponent("https-everywhere", &https_everywhere_service, install_dir,
+                  &task_environment);
+    RunBenchmark("https-everywhere", corpus, iterations,
+        [&](const CorpusEntry& entry) {
+          // As on the IO thread, with the blocking lookup on a miss.
+          std::string new_url;
+          if (!https_everywhere_service.GetHTTPSURLFromMemory(&entry.url,
+                                                              new_url)) {
+            https_everywhere_service.GetHTTPSURL(&entry.url, new_url);
+          }
+          return !new_url.empty();
+        });
+  }
+
+  if (command_line->HasSwitch(kAdBlockDirSwitch) &&
+      command_line->HasSwitch(kTrackingProtectionDirSwitch)) {
+    // Every shield up, as for a site without exceptions.
+    brave_shields::ShieldsPolicy policy;
+    RunBenchmark("throttle", corpus, iterations,
+        [&](const CorpusEntry& entry) {
+          brave_shields::ShieldsBlockDecision decision =
+              brave_shields::GetShieldsBlockDecision(policy,
+                  &tracking_protection_service, &ad_block_service,
+                  entry.url, entry.resource_type, entry.tab_host, false);
+          return decision.block_trackers || decision.block_ads;
+        });
+  }
+
+#if BUILDFLAG(USE_ALLOCATOR_SHIM)
+  base::allocator::RemoveAllocatorDispatchForTesting(&g_counting_dispatch);
+#endif
+  return 0;
+}
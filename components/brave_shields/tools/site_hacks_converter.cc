@@ -0,0 +1,57 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+// Converts the JSON site hacks rules into the binary index shipped by the
+// site hacks component.
+//
+// Usage: site_hacks_converter <json file> <output file>
+
+#include <string>
+
+#include "base/command_line.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/logging.h"
+#include "brave/components/brave_shields/browser/site_hacks_rule_table.h"
+
+int main(int argc, char* argv[]) {
+  base::CommandLine::Init(argc, argv);
+  const base::CommandLine::StringVector args =
+      base::CommandLine::ForCurrentProcess()->GetArgs();
+  if (args.size() != 2) {
+    LOG(ERROR) << "Usage: site_hacks_converter <json file> <output file>";
+    return 1;
+  }
+  const base::FilePath json_path(args[0]);
+  const base::FilePath output_path(args[1]);
+
+  std::string json;
+  if (!base::ReadFileToString(json_path, &json)) {
+    LOG(ERROR) << "Failed to read " << json_path.value();
+    return 1;
+  }
+  scoped_refptr<brave_shields::SiteHacksRuleTable> rules =
+      brave_shields::SiteHacksRuleTable::Parse(json);
+  if (!rules) {
+    LOG(ERROR) << "Invalid site hacks " << json_path.value();
+    return 1;
+  }
+
+  std::string output;
+  rules->Serialize(&output);
+  if (base::WriteFile(output_path, output.data(), output.size()) !=
+      static_cast<int>(output.size())) {
+    LOG(ERROR) << "Failed to write " << output_path.value();
+    return 1;
+  }
+
+  // Make sure what we wrote can be read back.
+  scoped_refptr<brave_shields::SiteHacksRuleTable> index =
+      brave_shields::SiteHacksRuleTable::ParseIndex(output);
+  if (!index || index->size() != rules->size()) {
+    LOG(ERROR) << "Verification of " << output_path.value() << " failed";
+    return 1;
+  }
+  return 0;
+}
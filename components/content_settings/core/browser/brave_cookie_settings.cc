@@ -4,9 +4,32 @@
 
 #include "brave/components/content_settings/core/browser/brave_cookie_settings.h"
 
+#include "base/strings/string_number_conversions.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
+#include "components/content_settings/core/browser/host_content_settings_map.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
-#include "url/gurl.h"
+
+namespace {
+
+// Enough for the sites of a busy session, each entry is a few origins.
+const size_t kDecisionCacheSize = 1000;
+
+// Content setting patterns only look at the scheme, host and port of http(s)
+// URLs, which are also all that decides first vs third party.
+bool IsCacheable(const GURL& url) {
+  return url.SchemeIsHTTPOrHTTPS() && url.has_host();
+}
+
+void AppendOriginKey(const GURL& url, std::string* key) {
+  url.scheme_piece().AppendToString(key);
+  key->append("://");
+  url.host_piece().AppendToString(key);
+  key->push_back(':');
+  key->append(base::IntToString(url.EffectiveIntPort()));
+  key->push_back(' ');
+}
+
+}  // namespace
 
 namespace content_settings {
 
@@ -16,11 +39,47 @@ BraveCookieSettings::BraveCookieSettings(
     HostContentSettingsMap* host_content_settings_map,
     PrefService* prefs,
     const char* extension_scheme)
-    : CookieSettings(host_content_settings_map, prefs, extension_scheme)
-{ }
+    : CookieSettings(host_content_settings_map, prefs, extension_scheme),
+      about_blank_url_("about:blank"),
+      first_party_placeholder_url_("https://firstParty/"),
+      decision_cache_(kDecisionCacheSize),
+      decision_cache_generation_(0),
+      decision_cache_block_third_party_(false),
+      settings_generation_(0),
+      decision_cache_hits_(0),
+      decision_cache_misses_(0) {
+  host_content_settings_map_->AddObserver(this);
+}
 
 BraveCookieSettings::~BraveCookieSettings() { }
 
+void BraveCookieSettings::ShutdownOnUIThread() {
+  host_content_settings_map_->RemoveObserver(this);
+  CookieSettings::ShutdownOnUIThread();
+}
+
+void BraveCookieSettings::OnContentSettingChanged(
+    const ContentSettingsPattern& primary_pattern,
+    const ContentSettingsPattern& secondary_pattern,
+    ContentSettingsType content_type,
+    std::string resource_identifier) {
+  if (content_type == CONTENT_SETTINGS_TYPE_COOKIES ||
+      content_type == CONTENT_SETTINGS_TYPE_PLUGINS ||
+      content_type == CONTENT_SETTINGS_TYPE_DEFAULT) {
+    settings_generation_++;
+  }
+}
+
+BraveCookieDecisionCacheStats
+BraveCookieSettings::GetDecisionCacheStats() const {
+  BraveCookieDecisionCacheStats stats;
+  stats.hits = decision_cache_hits_;
+  stats.misses = decision_cache_misses_;
+  base::AutoLock lock(decision_cache_lock_);
+  stats.size = decision_cache_.size();
+  return stats;
+}
+
 void BraveCookieSettings::GetCookieSetting(const GURL& url,
     const GURL& first_party_url,
     content_settings::SettingSource* source,
@@ -38,6 +97,57 @@ void BraveCookieSettings::GetCookieSetting(const GURL& url,
     content_settings::SettingSource* source,
     ContentSetting* cookie_setting) const {
   DCHECK(cookie_setting);
+  // Callers asking for the source need the full lookup.
+  if (source || !IsCacheable(url) || !IsCacheable(tab_url) ||
+      (!first_party_url.is_empty() && !IsCacheable(first_party_url))) {
+    GetCookieSettingUncached(url, first_party_url, tab_url, source,
+                             cookie_setting);
+    return;
+  }
+
+  std::string key;
+  AppendOriginKey(tab_url, &key);
+  if (!first_party_url.is_empty()) {
+    AppendOriginKey(first_party_url, &key);
+  }
+  key.push_back('|');
+  AppendOriginKey(url, &key);
+
+  const int generation = settings_generation_;
+  const bool block_third_party = ShouldBlockThirdPartyCookies();
+  {
+    base::AutoLock lock(decision_cache_lock_);
+    if (decision_cache_generation_ != generation ||
+        decision_cache_block_third_party_ != block_third_party) {
+      decision_cache_.Clear();
+      decision_cache_generation_ = generation;
+      decision_cache_block_third_party_ = block_third_party;
+    }
+    auto it = decision_cache_.Get(key);
+    if (it != decision_cache_.end()) {
+      decision_cache_hits_++;
+      *cookie_setting = it->second;
+      return;
+    }
+  }
+  decision_cache_misses_++;
+
+  GetCookieSettingUncached(url, first_party_url, tab_url, nullptr,
+                           cookie_setting);
+
+  base::AutoLock lock(decision_cache_lock_);
+  // Settings may have changed during the lookup, then the decision is
+  // dropped with the rest of the cache on the next call.
+  if (decision_cache_generation_ == generation) {
+    decision_cache_.Put(key, *cookie_setting);
+  }
+}
+
+void BraveCookieSettings::GetCookieSettingUncached(const GURL& url,
+    const GURL& first_party_url,
+    const GURL& tab_url,
+    content_settings::SettingSource* source,
+    ContentSetting* cookie_setting) const {
   CookieSettings::GetCookieSetting(url, first_party_url, source,
       cookie_setting);
 
@@ -46,7 +156,7 @@ void BraveCookieSettings::GetCookieSetting(const GURL& url,
     return;
   }
 
-  GURL primary_brave_url = tab_url == GURL("about:blank") ?
+  const GURL& primary_brave_url = tab_url == about_blank_url_ ?
       first_party_url : tab_url;
 
   // Check the Brave shields setting, if it is off, just return without
@@ -62,7 +172,7 @@ void BraveCookieSettings::GetCookieSetting(const GURL& url,
 
   // First party setting of block means always block everything
   ContentSetting brave_1p_setting = host_content_settings_map_->GetContentSetting(
-      primary_brave_url, GURL("https://firstParty/"),
+      primary_brave_url, first_party_placeholder_url_,
       CONTENT_SETTINGS_TYPE_PLUGINS, brave_shields::kCookies);
   if (brave_1p_setting == CONTENT_SETTING_BLOCK) {
     *cookie_setting = CONTENT_SETTING_BLOCK;
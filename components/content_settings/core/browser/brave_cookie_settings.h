@@ -5,11 +5,29 @@
 #ifndef BRAVE_COMPONENTS_CONTENT_SETTINGS_CORE_BROWSER_BRAVE_COOKIE_SETTINGS_H_
 #define BRAVE_COMPONENTS_CONTENT_SETTINGS_CORE_BROWSER_BRAVE_COOKIE_SETTINGS_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <string>
+
+#include "base/containers/mru_cache.h"
+#include "base/synchronization/lock.h"
+#include "components/content_settings/core/browser/content_settings_observer.h"
 #include "components/content_settings/core/browser/cookie_settings.h"
+#include "url/gurl.h"
 
 namespace content_settings {
 
-class BraveCookieSettings : public CookieSettings {
+// Counters describing how well the cookie decision cache is doing.
+struct BraveCookieDecisionCacheStats {
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  size_t size = 0;
+};
+
+class BraveCookieSettings : public CookieSettings,
+                            public content_settings::Observer {
  public:
   BraveCookieSettings(HostContentSettingsMap* host_content_settings_map,
                       PrefService* prefs,
@@ -29,8 +47,47 @@ class BraveCookieSettings : public CookieSettings {
   bool IsCookieAccessAllowed(const GURL& url,
                              const GURL& first_party_url,
                              const GURL& tab_url) const;
+
+  BraveCookieDecisionCacheStats GetDecisionCacheStats() const;
+
+  // RefcountedKeyedService:
+  void ShutdownOnUIThread() override;
+
  protected:
   ~BraveCookieSettings() override;
+
+ private:
+  // content_settings::Observer:
+  void OnContentSettingChanged(const ContentSettingsPattern& primary_pattern,
+                               const ContentSettingsPattern& secondary_pattern,
+                               ContentSettingsType content_type,
+                               std::string resource_identifier) override;
+
+  // Works out the setting without looking at the decision cache.
+  void GetCookieSettingUncached(const GURL& url,
+                                const GURL& first_party_url,
+                                const GURL& tab_url,
+                                content_settings::SettingSource* source,
+                                ContentSetting* cookie_setting) const;
+
+  const GURL about_blank_url_;
+  const GURL first_party_placeholder_url_;
+
+  // Decisions by the origins of the tab, first party and cookie URLs, which
+  // are all content setting patterns look at for them. Keying by eTLD+1 would
+  // be coarser than the settings themselves: a pattern may name one
+  // subdomain, scheme or port, so two origins of a site can get different
+  // decisions. Cleared whenever a content setting or the third party cookie
+  // preference changes.
+  mutable base::Lock decision_cache_lock_;
+  mutable base::HashingMRUCache<std::string, ContentSetting> decision_cache_;
+  mutable int decision_cache_generation_;
+  mutable bool decision_cache_block_third_party_;
+  // Bumped on the UI thread for every content setting change.
+  std::atomic<int> settings_generation_;
+  mutable std::atomic<uint64_t> decision_cache_hits_;
+  mutable std::atomic<uint64_t> decision_cache_misses_;
+
   DISALLOW_COPY_AND_ASSIGN(BraveCookieSettings);
 };
 
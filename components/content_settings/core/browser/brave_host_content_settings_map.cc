@@ -13,7 +13,8 @@ BraveHostContentSettingsMap::BraveHostContentSettingsMap(
     bool is_guest_profile,
     bool store_last_modified)
     : HostContentSettingsMap(prefs, is_incognito_profile, is_guest_profile,
-        store_last_modified) {
+        store_last_modified),
+      settings_version_(0) {
   InitializeFingerprintingContentSetting();
   InitializeReferrerContentSetting();
   InitializeCookieContentSetting();
@@ -24,6 +25,20 @@ BraveHostContentSettingsMap::BraveHostContentSettingsMap(
 BraveHostContentSettingsMap::~BraveHostContentSettingsMap() {
 }
 
+uint64_t BraveHostContentSettingsMap::GetSettingsVersion() const {
+  return settings_version_.load();
+}
+
+void BraveHostContentSettingsMap::OnContentSettingChanged(
+    const ContentSettingsPattern& primary_pattern,
+    const ContentSettingsPattern& secondary_pattern,
+    ContentSettingsType content_type,
+    std::string resource_identifier) {
+  settings_version_++;
+  HostContentSettingsMap::OnContentSettingChanged(primary_pattern,
+      secondary_pattern, content_type, resource_identifier);
+}
+
 void BraveHostContentSettingsMap::InitializeFingerprintingContentSetting() {
   SetContentSettingCustomScope(
       ContentSettingsPattern::Wildcard(),
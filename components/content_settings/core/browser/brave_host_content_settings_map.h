@@ -5,6 +5,10 @@
 #ifndef BRAVE_COMPONENTS_CONTENT_SETTINGS_CORE_BROWSER_BRAVE_HOST_CONTENT_SETTINGS_MAP_H_
 #define BRAVE_COMPONENTS_CONTENT_SETTINGS_CORE_BROWSER_BRAVE_HOST_CONTENT_SETTINGS_MAP_H_
 
+#include <stdint.h>
+
+#include <atomic>
+
 #include "components/content_settings/core/browser/host_content_settings_map.h"
 
 class BraveHostContentSettingsMap : public HostContentSettingsMap {
@@ -13,6 +17,18 @@ class BraveHostContentSettingsMap : public HostContentSettingsMap {
                                bool is_incognito_profile,
                                bool is_guest_profile,
                                bool store_last_modified);
+
+   // Bumped on every content setting change. Lets caches living on other
+   // threads notice that they are stale without observing the map.
+   uint64_t GetSettingsVersion() const;
+
+   // content_settings::Observer:
+   void OnContentSettingChanged(
+       const ContentSettingsPattern& primary_pattern,
+       const ContentSettingsPattern& secondary_pattern,
+       ContentSettingsType content_type,
+       std::string resource_identifier) override;
+
  private:
    void InitializeFingerprintingContentSetting();
    void InitializeReferrerContentSetting();
@@ -20,6 +36,8 @@ class BraveHostContentSettingsMap : public HostContentSettingsMap {
    void InitializeBraveShieldsContentSetting();
    void InitializeFlashContentSetting();
    ~BraveHostContentSettingsMap() override;
+
+   std::atomic<uint64_t> settings_version_;
 };
 
 #endif // BRAVE_COMPONENTS_CONTENT_SETTINGS_CORE_BROWSER_BRAVE_HOST_CONTENT_SETTINGS_MAP_H_
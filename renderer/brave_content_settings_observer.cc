@@ -4,9 +4,11 @@
 
 #include "brave/renderer/brave_content_settings_observer.h"
 
+#include "base/lazy_instance.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/common/render_messages.h"
 #include "brave/content/common/frame_messages.h"
+#include "brave/renderer/brave_content_settings_rule_index.h"
 #include "components/content_settings/core/common/content_settings_pattern.h"
 #include "content/public/renderer/render_frame.h"
 #include "services/service_manager/public/cpp/interface_provider.h"
@@ -16,18 +18,68 @@
 #include "third_party/blink/public/web/web_local_frame.h"
 #include "url/url_constants.h"
 
+namespace {
+
+// Pages loading scripts from more origins than this start over.
+const size_t kMaxCachedScriptDecisions = 256;
+
+// The rules are the same for every frame of the process, so they are compiled
+// once per process. Only used on the render thread.
+struct CompiledRules {
+  CompiledRules() : built(false), generation(0) {}
+
+  void Build(const RendererContentSettingRules& rules) {
+    brave_shields_rules.Build(rules.brave_shields_rules);
+    fingerprinting_rules.Build(rules.fingerprinting_rules);
+    built = true;
+    generation++;
+  }
+
+  BraveContentSettingsRuleIndex brave_shields_rules;
+  BraveContentSettingsRuleIndex fingerprinting_rules;
+  bool built;
+  // Changes whenever new rules arrive, so frames can drop their decisions.
+  int generation;
+};
+
+base::LazyInstance<CompiledRules>::Leaky g_compiled_rules =
+    LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
 BraveContentSettingsObserver::BraveContentSettingsObserver(
     content::RenderFrame* render_frame,
     extensions::Dispatcher* extension_dispatcher,
     bool should_whitelist,
     service_manager::BinderRegistry* registry)
     : ContentSettingsObserver(render_frame, extension_dispatcher,
-          should_whitelist, registry) {
+          should_whitelist, registry),
+      script_decisions_generation_(0) {
 }
 
 BraveContentSettingsObserver::~BraveContentSettingsObserver() {
 }
 
+// static
+void BraveContentSettingsObserver::OnContentSettingRulesUpdated(
+    const RendererContentSettingRules& rules) {
+  g_compiled_rules.Get().Build(rules);
+}
+
+const BraveContentSettingsRuleIndex*
+BraveContentSettingsObserver::GetCompiledRules(bool fingerprinting) {
+  if (!content_setting_rules_) {
+    return nullptr;
+  }
+  CompiledRules& compiled = g_compiled_rules.Get();
+  if (!compiled.built) {
+    // The rules were set without going through the render thread observer.
+    compiled.Build(*content_setting_rules_);
+  }
+  return fingerprinting ? &compiled.fingerprinting_rules
+                        : &compiled.brave_shields_rules;
+}
+
 bool BraveContentSettingsObserver::OnMessageReceived(const IPC::Message& message) {
   bool handled = true;
   IPC_BEGIN_MESSAGE_MAP(BraveContentSettingsObserver, message)
@@ -49,6 +101,7 @@ void BraveContentSettingsObserver::DidCommitProvisionalLoad(
   if (!is_same_document_navigation) {
     temporarily_allowed_scripts_ =
       std::move(preloaded_temporarily_allowed_scripts_);
+    script_decisions_.clear();
   }
 
   ContentSettingsObserver::DidCommitProvisionalLoad(
@@ -99,12 +152,40 @@ bool BraveContentSettingsObserver::AllowScriptFromSource(
     const blink::WebURL& script_url) {
   const GURL secondary_url(script_url);
 
+  // Rules only look at the origin of http(s) scripts, so the decision is
+  // the same for every script from that origin in this document.
+  const bool cacheable =
+      enabled_per_settings && secondary_url.SchemeIsHTTPOrHTTPS();
+  std::string origin;
+  if (cacheable) {
+    const int generation = g_compiled_rules.Get().generation;
+    if (script_decisions_generation_ != generation) {
+      script_decisions_.clear();
+      script_decisions_generation_ = generation;
+    }
+    origin = secondary_url.GetOrigin().spec();
+    auto it = script_decisions_.find(origin);
+    if (it != script_decisions_.end()) {
+      if (!it->second) {
+        blocked_script_url_ = secondary_url;
+      }
+      return it->second;
+    }
+  }
+
   bool allow = ContentSettingsObserver::AllowScriptFromSource(
       enabled_per_settings, script_url);
   allow = allow ||
     IsBraveShieldsDown(render_frame()->GetWebFrame(), secondary_url) ||
     IsScriptTemporilyAllowed(secondary_url);
 
+  if (cacheable) {
+    if (script_decisions_.size() >= kMaxCachedScriptDecisions) {
+      script_decisions_.clear();
+    }
+    script_decisions_[origin] = allow;
+  }
+
   if (!allow) {
     blocked_script_url_ = secondary_url;
   }
@@ -130,39 +211,26 @@ GURL BraveContentSettingsObserver::GetOriginOrURL(const blink::WebFrame* frame)
 }
 
 ContentSetting BraveContentSettingsObserver::GetContentSettingFromRules(
-    const ContentSettingsForOneType& rules,
-    const blink::WebFrame* frame,
+    const BraveContentSettingsRuleIndex& rules,
+    const GURL& primary_url,
     const GURL& secondary_url) {
-
-  const GURL& primary_url = GetOriginOrURL(frame);
-
-  for (const auto& rule : rules) {
-    ContentSettingsPattern secondary_pattern = rule.secondary_pattern;
-    if (rule.secondary_pattern ==
-        ContentSettingsPattern::FromString("https://firstParty/*")) {
-      secondary_pattern = ContentSettingsPattern::FromString(
-          "[*.]" + GetOriginOrURL(frame).HostNoBrackets());
-    }
-
-    if (rule.primary_pattern.Matches(primary_url) &&
-        (secondary_pattern == ContentSettingsPattern::Wildcard() ||
-         secondary_pattern.Matches(secondary_url))) {
-      return rule.GetContentSetting();
-    }
+  if (primary_url.host_piece() != first_party_host_) {
+    primary_url.host_piece().CopyToString(&first_party_host_);
+    first_party_pattern_ =
+        BraveContentSettingsRuleIndex::GetFirstPartyPattern(primary_url);
   }
-
-  // for cases which are third party resources and doesn't match any existing
-  // rules, block them by default
-  return CONTENT_SETTING_BLOCK;
+  return rules.GetContentSetting(primary_url, secondary_url,
+                                 first_party_pattern_);
 }
 
 bool BraveContentSettingsObserver::IsBraveShieldsDown(
     const blink::WebFrame* frame,
     const GURL& secondary_url) {
   ContentSetting setting = CONTENT_SETTING_DEFAULT;
-  if (content_setting_rules_) {
+  const BraveContentSettingsRuleIndex* rules = GetCompiledRules(false);
+  if (rules) {
     setting = GetContentSettingFromRules(
-        content_setting_rules_->brave_shields_rules, frame, secondary_url);
+        *rules, GetOriginOrURL(frame), secondary_url);
   }
 
   return setting == CONTENT_SETTING_BLOCK;
@@ -179,9 +247,10 @@ bool BraveContentSettingsObserver::AllowFingerprinting(
   if (IsBraveShieldsDown(frame, secondary_url)) {
     return true;
   }
-  if (content_setting_rules_) {
+  const BraveContentSettingsRuleIndex* rules = GetCompiledRules(true);
+  if (rules) {
     ContentSetting setting = GetContentSettingFromRules(
-        content_setting_rules_->fingerprinting_rules, frame, secondary_url);
+        *rules, GetOriginOrURL(frame), secondary_url);
     allow = setting != CONTENT_SETTING_BLOCK;
   }
   allow = allow || IsWhitelistedForContentSettings();
@@ -5,15 +5,22 @@
 #ifndef BRAVE_RENDERER_CONTENT_SETTINGS_OBSERVER_H_
 #define BRAVE_RENDERER_CONTENT_SETTINGS_OBSERVER_H_
 
+#include <string>
+#include <vector>
+
+#include "base/containers/flat_map.h"
 #include "base/strings/string16.h"
 #include "chrome/renderer/content_settings_observer.h"
 #include "components/content_settings/core/common/content_settings.h"
+#include "components/content_settings/core/common/content_settings_pattern.h"
 #include "components/content_settings/core/common/content_settings_types.h"
 
 namespace blink {
 class WebLocalFrame;
 }
 
+class BraveContentSettingsRuleIndex;
+
 // Handles blocking content per content settings for each RenderFrame.
 class BraveContentSettingsObserver
     : public ContentSettingsObserver {
@@ -24,6 +31,11 @@ class BraveContentSettingsObserver
                                service_manager::BinderRegistry* registry);
   ~BraveContentSettingsObserver() override;
 
+  // Compiles the rules the browser sent to this process. Called by the render
+  // thread observer whenever new rules arrive.
+  static void OnContentSettingRulesUpdated(
+      const RendererContentSettingRules& rules);
+
  protected:
   bool AllowScript(bool enabled_per_settings) override;
   void DidNotAllowScript() override;
@@ -43,9 +55,13 @@ class BraveContentSettingsObserver
  private:
   GURL GetOriginOrURL(const blink::WebFrame* frame);
 
+  // The compiled Brave Shields or fingerprinting rules, nullptr if no rules
+  // were set for this frame.
+  const BraveContentSettingsRuleIndex* GetCompiledRules(bool fingerprinting);
+
   ContentSetting GetContentSettingFromRules(
-      const ContentSettingsForOneType& rules,
-      const blink::WebFrame* frame,
+      const BraveContentSettingsRuleIndex& rules,
+      const GURL& primary_url,
       const GURL& secondary_url);
 
   bool IsBraveShieldsDown(
@@ -70,6 +86,16 @@ class BraveContentSettingsObserver
   // temporary allowed script origins we preloaded for the next load
   base::flat_set<std::string> preloaded_temporarily_allowed_scripts_;
 
+  // AllowScriptFromSource() decisions by script origin for the current
+  // document, valid for the rules of |script_decisions_generation_|.
+  base::flat_map<std::string, bool> script_decisions_;
+  int script_decisions_generation_;
+
+  // "[*.]" followed by |first_party_host_|, which is the host of the last
+  // primary URL rules were matched for.
+  std::string first_party_host_;
+  ContentSettingsPattern first_party_pattern_;
+
   DISALLOW_COPY_AND_ASSIGN(BraveContentSettingsObserver);
 };
 
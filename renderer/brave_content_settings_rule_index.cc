@@ -0,0 +1,156 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/renderer/brave_content_settings_rule_index.h"
+
+#include "url/gurl.h"
+
+namespace {
+
+const char kDomainWildcard[] = "[*.]";
+
+// Returns the host a URL must have, or be a subdomain of, to match |pattern|,
+// or an empty string if the pattern may match any host.
+std::string GetPatternHost(const ContentSettingsPattern& pattern,
+                           bool* has_domain_wildcard) {
+  *has_domain_wildcard = false;
+  const std::string spec = pattern.ToString();
+  base::StringPiece host(spec);
+  size_t scheme_end = host.find("://");
+  if (scheme_end != base::StringPiece::npos) {
+    host.remove_prefix(scheme_end + 3);
+  }
+  if (host.starts_with(kDomainWildcard)) {
+    host.remove_prefix(arraysize(kDomainWildcard) - 1);
+    *has_domain_wildcard = true;
+  }
+  // Wildcard hosts and IPv6 literals are left to the full match.
+  if (host.empty() || host[0] == '*' || host[0] == '[') {
+    return std::string();
+  }
+  return host.substr(0, host.find_first_of(":/")).as_string();
+}
+
+}  // namespace
+
+BraveContentSettingsRuleIndex::Rule::Rule()
+    : first_party(false),
+      secondary_is_wildcard(false),
+      setting(CONTENT_SETTING_DEFAULT) {
+}
+
+BraveContentSettingsRuleIndex::Rule::Rule(const Rule& other) = default;
+
+BraveContentSettingsRuleIndex::Rule::~Rule() {
+}
+
+BraveContentSettingsRuleIndex::BraveContentSettingsRuleIndex()
+    : has_domain_wildcards_(false) {
+}
+
+BraveContentSettingsRuleIndex::~BraveContentSettingsRuleIndex() {
+}
+
+// static
+ContentSettingsPattern BraveContentSettingsRuleIndex::GetFirstPartyPattern(
+    const GURL& primary_url) {
+  return ContentSettingsPattern::FromString(
+      kDomainWildcard + primary_url.HostNoBrackets());
+}
+
+void BraveContentSettingsRuleIndex::Build(
+    const ContentSettingsForOneType& rules) {
+  rules_by_host_.clear();
+  any_host_rules_.clear();
+  has_domain_wildcards_ = false;
+  rules_.clear();
+  rules_.reserve(rules.size());
+
+  const ContentSettingsPattern first_party =
+      ContentSettingsPattern::FromString("https://firstParty/*");
+  const ContentSettingsPattern wildcard = ContentSettingsPattern::Wildcard();
+  for (const auto& source : rules) {
+    Rule rule;
+    rule.primary_pattern = source.primary_pattern;
+    rule.secondary_pattern = source.secondary_pattern;
+    rule.first_party = source.secondary_pattern == first_party;
+    rule.secondary_is_wildcard = source.secondary_pattern == wildcard;
+    rule.setting = source.GetContentSetting();
+    bool has_domain_wildcard;
+    rule.primary_host =
+        GetPatternHost(source.primary_pattern, &has_domain_wildcard);
+    if (!rule.primary_host.empty() && has_domain_wildcard) {
+      has_domain_wildcards_ = true;
+    }
+    rules_.push_back(rule);
+  }
+
+  // |rules_| must not change after this, the keys point into it.
+  for (size_t i = 0; i < rules_.size(); i++) {
+    if (rules_[i].primary_host.empty()) {
+      any_host_rules_.push_back(i);
+    } else {
+      rules_by_host_[rules_[i].primary_host].push_back(i);
+    }
+  }
+}
+
+bool BraveContentSettingsRuleIndex::Matches(
+    const Rule& rule,
+    const GURL& primary_url,
+    const GURL& secondary_url,
+    const ContentSettingsPattern& first_party_pattern) const {
+  if (!rule.primary_pattern.Matches(primary_url)) {
+    return false;
+  }
+  if (rule.first_party) {
+    return first_party_pattern.Matches(secondary_url);
+  }
+  return rule.secondary_is_wildcard ||
+      rule.secondary_pattern.Matches(secondary_url);
+}
+
+ContentSetting BraveContentSettingsRuleIndex::GetContentSetting(
+    const GURL& primary_url,
+    const GURL& secondary_url,
+    const ContentSettingsPattern& first_party_pattern) const {
+  // Rules come grouped by host, the first match in precedence order wins.
+  size_t first_match = rules_.size();
+  auto visit = [&](const std::vector<size_t>& candidates) {
+    for (size_t index : candidates) {
+      if (index >= first_match) {
+        break;
+      }
+      if (Matches(rules_[index], primary_url, secondary_url,
+                  first_party_pattern)) {
+        first_match = index;
+        break;
+      }
+    }
+  };
+
+  base::StringPiece host = primary_url.host_piece();
+  while (!host.empty()) {
+    auto it = rules_by_host_.find(host);
+    if (it != rules_by_host_.end()) {
+      visit(it->second);
+    }
+    if (!has_domain_wildcards_) {
+      break;
+    }
+    size_t dot = host.find('.');
+    if (dot == base::StringPiece::npos) {
+      break;
+    }
+    host.remove_prefix(dot + 1);
+  }
+  visit(any_host_rules_);
+
+  if (first_match == rules_.size()) {
+    // For cases which are third party resources and doesn't match any
+    // existing rules, block them by default.
+    return CONTENT_SETTING_BLOCK;
+  }
+  return rules_[first_match].setting;
+}
@@ -0,0 +1,79 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_RENDERER_BRAVE_CONTENT_SETTINGS_RULE_INDEX_H_
+#define BRAVE_RENDERER_BRAVE_CONTENT_SETTINGS_RULE_INDEX_H_
+
+#include <stddef.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/strings/string_piece.h"
+#include "components/content_settings/core/common/content_settings.h"
+#include "components/content_settings/core/common/content_settings_pattern.h"
+
+class GURL;
+
+// The content setting rules of one type, indexed by the host of their primary
+// pattern so that a lookup costs a hash lookup per host label instead of a
+// walk over all rules. Secondary patterns of "https://firstParty/*" are
+// recognized when the index is built instead of on every lookup.
+class BraveContentSettingsRuleIndex {
+ public:
+  BraveContentSettingsRuleIndex();
+  ~BraveContentSettingsRuleIndex();
+
+  // Replaces the indexed rules. |rules| are in precedence order.
+  void Build(const ContentSettingsForOneType& rules);
+
+  // Returns the setting of the first rule matching |primary_url| and
+  // |secondary_url|, or CONTENT_SETTING_BLOCK if there is none. First party
+  // rules match |secondary_url| against |first_party_pattern|, which is
+  // "[*.]" followed by the host of |primary_url|.
+  ContentSetting GetContentSetting(
+      const GURL& primary_url,
+      const GURL& secondary_url,
+      const ContentSettingsPattern& first_party_pattern) const;
+
+  size_t size() const { return rules_.size(); }
+
+  static ContentSettingsPattern GetFirstPartyPattern(const GURL& primary_url);
+
+ private:
+  struct Rule {
+    Rule();
+    Rule(const Rule& other);
+    ~Rule();
+
+    ContentSettingsPattern primary_pattern;
+    ContentSettingsPattern secondary_pattern;
+    // Empty if the primary pattern may match any host.
+    std::string primary_host;
+    bool first_party;
+    bool secondary_is_wildcard;
+    ContentSetting setting;
+  };
+
+  bool Matches(const Rule& rule,
+               const GURL& primary_url,
+               const GURL& secondary_url,
+               const ContentSettingsPattern& first_party_pattern) const;
+
+  std::vector<Rule> rules_;
+  // Keys point into the |primary_host| of |rules_|, values are in
+  // precedence order.
+  std::unordered_map<base::StringPiece, std::vector<size_t>,
+                     base::StringPieceHash> rules_by_host_;
+  // Rules whose primary pattern may match any host.
+  std::vector<size_t> any_host_rules_;
+  // Without domain wildcards only the full host has to be looked up.
+  bool has_domain_wildcards_;
+
+  DISALLOW_COPY_AND_ASSIGN(BraveContentSettingsRuleIndex);
+};
+
+#endif  // BRAVE_RENDERER_BRAVE_CONTENT_SETTINGS_RULE_INDEX_H_
@@ -0,0 +1,108 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/renderer/brave_content_settings_rule_index.h"
+
+#include <string>
+
+#include "base/values.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace {
+
+void AddRule(ContentSettingsForOneType* rules,
+             const std::string& primary_pattern,
+             const std::string& secondary_pattern,
+             ContentSetting setting) {
+  rules->push_back(ContentSettingPatternSource(
+      ContentSettingsPattern::FromString(primary_pattern),
+      ContentSettingsPattern::FromString(secondary_pattern),
+      base::Value(setting), std::string(), false));
+}
+
+ContentSetting GetSetting(const BraveContentSettingsRuleIndex& index,
+                          const std::string& primary_url,
+                          const std::string& secondary_url) {
+  const GURL primary(primary_url);
+  return index.GetContentSetting(
+      primary, GURL(secondary_url),
+      BraveContentSettingsRuleIndex::GetFirstPartyPattern(primary));
+}
+
+}  // namespace
+
+TEST(BraveContentSettingsRuleIndexTest, BlocksWithoutMatchingRule) {
+  BraveContentSettingsRuleIndex index;
+  index.Build(ContentSettingsForOneType());
+  EXPECT_EQ(CONTENT_SETTING_BLOCK,
+            GetSetting(index, "https://a.com/", "https://b.com/"));
+}
+
+TEST(BraveContentSettingsRuleIndexTest, MatchesPrimaryHosts) {
+  ContentSettingsForOneType rules;
+  AddRule(&rules, "http://a.com/*", "*", CONTENT_SETTING_ALLOW);
+  AddRule(&rules, "[*.]b.com", "*", CONTENT_SETTING_ALLOW);
+  BraveContentSettingsRuleIndex index;
+  index.Build(rules);
+  EXPECT_EQ(2u, index.size());
+
+  EXPECT_EQ(CONTENT_SETTING_ALLOW,
+            GetSetting(index, "http://a.com/", "https://c.com/"));
+  EXPECT_EQ(CONTENT_SETTING_BLOCK,
+            GetSetting(index, "http://www.a.com/", "https://c.com/"));
+  EXPECT_EQ(CONTENT_SETTING_ALLOW,
+            GetSetting(index, "https://b.com/", "https://c.com/"));
+  EXPECT_EQ(CONTENT_SETTING_ALLOW,
+            GetSetting(index, "https://www.b.com/", "https://c.com/"));
+  EXPECT_EQ(CONTENT_SETTING_BLOCK,
+            GetSetting(index, "https://notb.com/", "https://c.com/"));
+}
+
+TEST(BraveContentSettingsRuleIndexTest, KeepsPrecedenceOrder) {
+  ContentSettingsForOneType rules;
+  AddRule(&rules, "[*.]www.a.com", "*", CONTENT_SETTING_ALLOW);
+  AddRule(&rules, "*", "https://b.com/*", CONTENT_SETTING_BLOCK);
+  AddRule(&rules, "[*.]a.com", "*", CONTENT_SETTING_BLOCK);
+  AddRule(&rules, "*", "*", CONTENT_SETTING_ALLOW);
+  BraveContentSettingsRuleIndex index;
+  index.Build(rules);
+
+  EXPECT_EQ(CONTENT_SETTING_ALLOW,
+            GetSetting(index, "https://www.a.com/", "https://b.com/"));
+  EXPECT_EQ(CONTENT_SETTING_BLOCK,
+            GetSetting(index, "https://a.com/", "https://b.com/"));
+  EXPECT_EQ(CONTENT_SETTING_BLOCK,
+            GetSetting(index, "https://a.com/", "https://c.com/"));
+  EXPECT_EQ(CONTENT_SETTING_ALLOW,
+            GetSetting(index, "https://d.com/", "https://c.com/"));
+}
+
+TEST(BraveContentSettingsRuleIndexTest, ResolvesFirstParty) {
+  ContentSettingsForOneType rules;
+  AddRule(&rules, "*", "https://firstParty/*", CONTENT_SETTING_ALLOW);
+  BraveContentSettingsRuleIndex index;
+  index.Build(rules);
+
+  EXPECT_EQ(CONTENT_SETTING_ALLOW,
+            GetSetting(index, "https://a.com/", "https://a.com/x.js"));
+  EXPECT_EQ(CONTENT_SETTING_ALLOW,
+            GetSetting(index, "https://a.com/", "https://cdn.a.com/x.js"));
+  EXPECT_EQ(CONTENT_SETTING_BLOCK,
+            GetSetting(index, "https://a.com/", "https://b.com/x.js"));
+}
+
+TEST(BraveContentSettingsRuleIndexTest, RebuildReplacesRules) {
+  ContentSettingsForOneType rules;
+  AddRule(&rules, "[*.]a.com", "*", CONTENT_SETTING_ALLOW);
+  BraveContentSettingsRuleIndex index;
+  index.Build(rules);
+  EXPECT_EQ(CONTENT_SETTING_ALLOW,
+            GetSetting(index, "https://a.com/", "https://b.com/"));
+
+  index.Build(ContentSettingsForOneType());
+  EXPECT_EQ(0u, index.size());
+  EXPECT_EQ(CONTENT_SETTING_BLOCK,
+            GetSetting(index, "https://a.com/", "https://b.com/"));
+}